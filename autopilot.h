@@ -0,0 +1,297 @@
+// autopilot.h
+#ifndef AUTOPILOT_H
+#define AUTOPILOT_H
+
+#include "gameLogic.h"
+#include <algorithm>
+
+// ============================================================================
+// AUTOPILOT
+// ============================================================================
+
+/**
+ * @brief Pathfinding bot for demo mode and headless runs.
+ *
+ * Plans a shortest path to the food with a breadth-first search over the
+ * board and only commits to it if, after virtually eating along it (on a
+ * SearchState), the head can still reach the tail. Otherwise it follows its
+ * own tail the long way round, and as a last resort takes the move with the
+ * most free space.
+ *
+ * Tail-following never dies, but late in a game it can circle forever
+ * without a safe path opening up. After rows * cols ticks without eating
+ * the bot therefore takes the shortest path to the food even when it is
+ * unsafe, so every game (and the attract mode) eventually ends.
+ *
+ * A planned path stays valid while the food does not move: cells ahead of
+ * the head only ever get freed, so later ticks just advance along it and
+ * replan only when food is eaten or respawns. The visited stamps, parent
+ * links, queue and path are sized to rows * cols once and reused, so a
+ * tick allocates nothing after the first search on a board size.
+ *
+ * Usable as a HeadlessRunner policy, or via steer() on the logic thread.
+ */
+class Autopilot {
+private:
+    static constexpr uint32_t NO_CELL = UINT32_MAX;
+
+    vector<uint32_t> visited;   ///< Search stamp per cell; equal to stamp means seen
+    vector<uint32_t> parent;    ///< Previous cell on the search tree
+    vector<uint32_t> queue;     ///< BFS frontier, one slot per cell
+    vector<uint32_t> path;      ///< Planned cells, next step first
+    size_t pathPos = 0;
+    uint32_t plannedFood = NO_CELL;
+    uint32_t stamp = 0;
+    SearchState lookahead;
+    int lastScore = 0;
+    size_t hungryTicks = 0;     ///< Moves chosen since the score last changed
+
+    /**
+     * @brief Sizes the buffers for a board once per board size.
+     * @param cells Number of board cells
+     */
+    void prepare(size_t cells) {
+        if (visited.size() == cells) return;
+        visited.assign(cells, 0);
+        parent.assign(cells, NO_CELL);
+        queue.resize(cells);
+        path.reserve(cells);
+        lookahead.reserve(cells, 1);
+        stamp = 0;
+        plannedFood = NO_CELL;
+    }
+
+    uint32_t nextStamp() {
+        if (++stamp == 0) {
+            fill(visited.begin(), visited.end(), 0);
+            stamp = 1;
+        }
+        return stamp;
+    }
+
+    /**
+     * @brief Breadth-first search from a cell through free cells.
+     *
+     * Snake and wall cells block, except target itself. Leaves parent links
+     * for the visited cells.
+     * @param board Game board
+     * @param from Start cell (the head)
+     * @param target Goal cell, or NO_CELL to flood-fill
+     * @return Cells visited (excluding from) if flood-filling, otherwise 1 if
+     *         target was reached and 0 if not
+     */
+    size_t bfs(const Board& board, uint32_t from, uint32_t target) {
+        uint32_t mark = nextStamp();
+        uint32_t rows = static_cast<uint32_t>(board.getRows());
+        uint32_t cols = static_cast<uint32_t>(board.getCols());
+        size_t head = 0, tail = 0;
+        queue[tail++] = from;
+        visited[from] = mark;
+
+        while (head < tail) {
+            uint32_t cell = queue[head++];
+            uint32_t r = cell / cols;
+            uint32_t c = cell % cols;
+            uint32_t neighbours[4] = {
+                r > 0 ? cell - cols : NO_CELL,
+                r + 1 < rows ? cell + cols : NO_CELL,
+                c > 0 ? cell - 1 : NO_CELL,
+                c + 1 < cols ? cell + 1 : NO_CELL};
+
+            for (uint32_t next : neighbours) {
+                if (next == NO_CELL || visited[next] == mark) continue;
+                if (next == target) {
+                    parent[next] = cell;
+                    return 1;
+                }
+                CellType type = board.getCell(next);
+                if (type == SNAKE || type == WALL) continue;
+                visited[next] = mark;
+                parent[next] = cell;
+                queue[tail++] = next;
+            }
+        }
+        return target == NO_CELL ? tail - 1 : 0;
+    }
+
+    /**
+     * @brief Gets the first step of the path found by the last search.
+     * @param from Start cell of the search
+     * @param target Cell the search reached
+     * @return Cell adjacent to from on the way to target
+     */
+    uint32_t firstStep(uint32_t from, uint32_t target) const {
+        uint32_t cell = target;
+        while (parent[cell] != from) {
+            cell = parent[cell];
+        }
+        return cell;
+    }
+
+    /**
+     * @brief Counts the steps of the path found by the last search.
+     * @param from Start cell of the search
+     * @param target Cell the search reached
+     * @return Number of moves from from to target
+     */
+    size_t pathLength(uint32_t from, uint32_t target) const {
+        size_t length = 1;
+        for (uint32_t cell = target; parent[cell] != from; cell = parent[cell]) {
+            length++;
+        }
+        return length;
+    }
+
+    static Direction directionTo(uint32_t from, uint32_t to, int cols) {
+        if (to + cols == from) return UP;
+        if (to == from + cols) return DOWN;
+        if (to + 1 == from) return LEFT;
+        return RIGHT;
+    }
+
+    /**
+     * @brief Plans a path to the food that leaves the tail reachable.
+     * @param game Game being played
+     * @param head Current head cell
+     * @param food Current food cell
+     * @return True if path now holds a safe plan
+     */
+    bool planToFood(const SnakeGameLogic& game, uint32_t head, uint32_t food) {
+        path.clear();
+        pathPos = 0;
+        if (!bfs(game.getBoard(), head, food)) return false;
+
+        for (uint32_t cell = food; cell != head; cell = parent[cell]) {
+            path.push_back(cell);
+        }
+        reverse(path.begin(), path.end());
+
+        // Eat along the path on a private copy, then check the tail is
+        // still in reach so the snake cannot trap itself after eating
+        game.loadSearchState(lookahead);
+        int cols = game.getBoard().getCols();
+        uint32_t previous = head;
+        for (uint32_t cell : path) {
+            if (!SnakeGameLogic::simulate(lookahead, directionTo(previous, cell, cols))) {
+                return lookahead.get().board.isFull() && !lookahead.get().foodExists;
+            }
+            previous = cell;
+        }
+
+        const GameCheckpoint& after = lookahead.get();
+        uint32_t virtualHead = after.snake.getSegmentIndex(0);
+        uint32_t virtualTail = after.snake.getSegmentIndex(after.snake.getLength() - 1);
+        return virtualHead == virtualTail || bfs(after.board, virtualHead, virtualTail);
+    }
+
+public:
+    /**
+     * @brief Checks whether the head may enter a cell on the next move.
+     * 
+     * The neck is excluded even when it is the tail, since turning into it
+     * is a reversal that the direction controller ignores.
+     * @param board Game board
+     * @param snake Snake on that board
+     * @param cell Flat index of the cell
+     * @return True if moving there does not end the game
+     */
+    static bool canEnter(const Board& board, const Snake& snake, uint32_t cell) {
+        if (snake.getLength() > 1 && cell == snake.getSegmentIndex(1)) return false;
+        CellType type = board.getCell(cell);
+        if (type == WALL) return false;
+        return type != SNAKE || !snake.checkSelfCollision(board.toPosition(cell), board);
+    }
+
+    void reset(unsigned int) {
+        plannedFood = NO_CELL;
+        path.clear();
+        pathPos = 0;
+        lastScore = 0;
+        hungryTicks = 0;
+    }
+
+    /**
+     * @brief Chooses the next move for the live game (logic thread).
+     * @param game Game being played
+     * @return Direction to queue, or NONE when every move is fatal
+     */
+    Direction operator()(const SnakeGameLogic& game) {
+        const Board& board = game.getBoard();
+        const Snake& snake = game.getSnake();
+        prepare(board.getCellCount());
+
+        uint32_t head = snake.getSegmentIndex(0);
+        uint32_t food = NO_CELL;
+        if (game.getFoodManager().isPresent()) {
+            pair<int, int> position = game.getFoodManager().getPosition();
+            food = static_cast<uint32_t>(board.toIndex(position.first, position.second));
+        }
+
+        if (game.getLiveScore() != lastScore) {
+            lastScore = game.getLiveScore();
+            hungryTicks = 0;
+        }
+        bool stalled = ++hungryTicks > board.getCellCount();
+
+        // Keep following the plan while the food stays put
+        bool onPlan = food != NO_CELL && food == plannedFood && pathPos < path.size() &&
+                      (pathPos == 0 || path[pathPos - 1] == head) && canEnter(board, snake, path[pathPos]);
+        if (!onPlan) {
+            plannedFood = NO_CELL;
+            // planToFood leaves the shortest path in place even when it
+            // rejects it as unsafe; a stalled snake takes it anyway
+            if (food != NO_CELL && (planToFood(game, head, food) || (stalled && !path.empty()))) {
+                plannedFood = food;
+                onPlan = canEnter(board, snake, path[0]);
+            }
+        }
+        if (onPlan) {
+            return directionTo(head, path[pathPos++], board.getCols());
+        }
+
+        // No safe plan: take the move that keeps the tail in reach by the
+        // longest path, which stretches the body out and opens the board up
+        // (a moving tail always leaves room behind it); if none does, the
+        // move with the most reachable space
+        uint32_t tail = snake.getSegmentIndex(snake.getLength() - 1);
+        pair<int, int> position = board.toPosition(head);
+        static const int rowStep[] = {-1, 1, 0, 0};
+        static const int colStep[] = {0, 0, -1, 1};
+        Direction best = NONE;
+        bool bestSafe = false;
+        size_t bestScore = 0;
+        for (int dir = UP; dir <= RIGHT; dir++) {
+            int r = position.first + rowStep[dir];
+            int c = position.second + colStep[dir];
+            if (!board.isInBounds(r, c)) continue;
+            uint32_t cell = static_cast<uint32_t>(board.toIndex(r, c));
+            if (!canEnter(board, snake, cell)) continue;
+            
+            bool safe = cell == tail || bfs(board, cell, tail);
+            size_t score = safe ? (cell == tail ? 0 : pathLength(cell, tail)) : bfs(board, cell, NO_CELL) + 1;
+            if (best == NONE || safe > bestSafe || (safe == bestSafe && score > bestScore)) {
+                best = static_cast<Direction>(dir);
+                bestSafe = safe;
+                bestScore = score;
+            }
+        }
+        return best;
+    }
+
+    /**
+     * @brief Queues the autopilot's move on the game (logic thread).
+     *
+     * DirectionController's input ring is single-producer, and the plan
+     * assumes its own moves are the only ones queued: while steer() drives
+     * a game, nothing else (such as a key handler) may call setDirection().
+     * @param game Game to steer
+     */
+    void steer(SnakeGameLogic& game) {
+        Direction dir = (*this)(game);
+        if (dir != NONE) {
+            game.setDirection(dir);
+        }
+    }
+};
+
+#endif // AUTOPILOT_H
@@ -0,0 +1,341 @@
+// batchedEngine.h
+#ifndef BATCHEDENGINE_H
+#define BATCHEDENGINE_H
+
+#include "gameLogic.h"
+
+// ============================================================================
+// BATCHED ENGINE
+// ============================================================================
+
+/**
+ * @brief Steps many same-sized games in lockstep using structure-of-arrays storage.
+ * 
+ * Per-game scalars (head, direction, length, score, flags) live in parallel
+ * arrays and all boards are packed into one contiguous byte array, game after
+ * game. A step runs in two phases:
+ *   1. Branch-free loops over the arrays that apply inputs, compute next
+ *      heads and evaluate the bounds, wall, self and food checks for every
+ *      game at once; finished games are masked out rather than skipped.
+ *      gcc vectorizes the input, next-head and check loops at -O3 (its
+ *      -O2 cost model declines them); the board read between them is a
+ *      byte gather and stays scalar.
+ *   2. A scalar pass that applies the moves of games still running.
+ *
+ * `snake_headless --check-batched` plays these games against
+ * SnakeGameLogic tick by tick, and bench.cpp times batched_step.
+ * 
+ * Semantics reproduce SnakeGameLogic::update exactly: the same input
+ * validation as DirectionController (one queued input per game per
+ * step), the same check order as
+ * CollisionDetector (bounds, wall, self, food), the same tail-vacating
+ * rule, and the same row-major k-th empty cell and GameRng draw for food
+ * placement.
+ * A game reset with seed S therefore evolves bit-for-bit like
+ * SnakeGameLogic(S) fed the same directions.
+ */
+class BatchedSnakeEngine {
+private:
+    size_t gameCount;
+    int rows;
+    int cols;
+    size_t cellCount;
+    size_t wordCount;               ///< Empty-cell plane words per game
+    int startingLength;
+    int pointsPerFood;
+    Direction initialDirection;
+
+    // Per-game scalars (SoA)
+    vector<int32_t> headRow;
+    vector<int32_t> headCol;
+    vector<uint8_t> direction;
+    vector<uint32_t> length;
+    vector<uint32_t> headSlot;
+    vector<uint32_t> tailCell;
+    vector<int32_t> growthPending;
+    vector<int32_t> score;
+    vector<uint32_t> foodCell;
+    vector<uint8_t> foodPresent;
+    vector<uint8_t> done;
+    vector<uint32_t> emptyCount;
+    vector<GameRng> rngs;
+
+    // Per-game cell arrays, packed back to back (game * cellCount + cell)
+    vector<CellType> boards;
+    vector<uint64_t> emptyBits;     // game * wordCount + word, as in Board
+    vector<uint32_t> rings;
+
+    // Step scratch, one entry per game
+    vector<int32_t> nextRow;
+    vector<int32_t> nextCol;
+    vector<uint32_t> nextCell;
+    vector<uint8_t> cellAhead;      ///< Board cell at nextCell
+    vector<uint8_t> dies;
+    vector<uint8_t> eats;
+
+    // Board::setCell without the change log, on game g's slice
+    void setCell(size_t g, uint32_t index, CellType type) {
+        size_t base = g * cellCount;
+        CellType previous = boards[base + index];
+        if (previous == type) return;
+        boards[base + index] = type;
+        
+        if (previous == EMPTY || type == EMPTY) {
+            emptyBits[g * wordCount + (index >> 6)] ^= uint64_t(1) << (index & 63);
+            emptyCount[g] += type == EMPTY ? 1 : UINT32_MAX;
+        }
+    }
+
+    // FoodManager::placeRandom on game g
+    void placeFood(size_t g) {
+        if (emptyCount[g] == 0) {
+            foodPresent[g] = 0;
+            return;
+        }
+        uniform_int_distribution<size_t> dist(0, emptyCount[g] - 1);
+        size_t rank = dist(rngs[g]);
+        
+        // Board::getEmptyCell without the block counters (boards here are small)
+        const uint64_t* words = emptyBits.data() + g * wordCount;
+        size_t word = 0;
+        for (;; word++) {
+            size_t count = Board::countBits(words[word]);
+            if (rank < count) break;
+            rank -= count;
+        }
+        uint32_t index = static_cast<uint32_t>(word * 64 + Board::selectBit(words[word], static_cast<unsigned>(rank)));
+        setCell(g, index, FOOD);
+        foodCell[g] = index;
+        foodPresent[g] = 1;
+    }
+
+    uint32_t ringSlot(size_t g, uint32_t segment) const {
+        uint32_t slot = headSlot[g] + segment;
+        return slot < cellCount ? slot : slot - static_cast<uint32_t>(cellCount);
+    }
+
+    // Phase 1 loops take restrict parameters (gcc ignores restrict on
+    // locals): through members, every byte store could alias gameCount or
+    // a vector's data pointer and no loop vectorizes.
+
+    // Phase 1a: DirectionController::processInput. Opposite directions
+    // differ only in bit 0 (UP/DOWN, LEFT/RIGHT)
+    static void steerAll(size_t n, const Direction* __restrict input, uint8_t* __restrict dir) {
+        for (size_t g = 0; g < n; g++) {
+            uint32_t wanted = static_cast<uint32_t>(input[g]);
+            uint32_t current = dir[g];
+            bool accept = (wanted < NONE) & (wanted != (current ^ 1));
+            dir[g] = static_cast<uint8_t>(accept ? wanted : current);
+        }
+    }
+
+    // Phase 1b: DirectionController::getNextPosition and bounds check
+    static void aimAll(size_t n, int32_t rows, int32_t cols, const uint8_t* __restrict dir,
+                       const int32_t* __restrict row, const int32_t* __restrict col,
+                       int32_t* __restrict toRow, int32_t* __restrict toCol,
+                       uint32_t* __restrict toCell, uint8_t* __restrict dead) {
+        for (size_t g = 0; g < n; g++) {
+            int32_t d = dir[g];
+            int32_t r = row[g] + (d == DOWN) - (d == UP);
+            int32_t c = col[g] + (d == RIGHT) - (d == LEFT);
+            toRow[g] = r;
+            toCol[g] = c;
+            bool inBounds = (static_cast<uint32_t>(r) < static_cast<uint32_t>(rows)) &
+                            (static_cast<uint32_t>(c) < static_cast<uint32_t>(cols));
+            dead[g] = !inBounds;
+            toCell[g] = inBounds ? static_cast<uint32_t>(r * cols + c) : 0;
+        }
+    }
+
+    // Phase 1c: wall, self and food checks, branch-free; finished games
+    // come out dead so phase 2 leaves them alone
+    static void checkAll(size_t n, const uint8_t* __restrict ahead, const uint32_t* __restrict toCell,
+                         const uint32_t* __restrict tail, const int32_t* __restrict growth,
+                         const uint32_t* __restrict food, const uint8_t* __restrict hasFood,
+                         const uint8_t* __restrict finished, uint8_t* __restrict dead,
+                         uint8_t* __restrict eat) {
+        for (size_t g = 0; g < n; g++) {
+            uint32_t index = toCell[g];
+            uint8_t wall = ahead[g] == WALL;
+            uint8_t self = (ahead[g] == SNAKE) & ((growth[g] > 0) | (index != tail[g]));
+            uint8_t died = dead[g] | wall | self | finished[g];
+            dead[g] = died;
+            eat[g] = (died ^ 1) & hasFood[g] & (index == food[g]);
+        }
+    }
+
+public:
+    /**
+     * @brief Allocates storage for a batch of games (all start finished).
+     * @param gameCount Number of games in the batch
+     * @param rows Number of board rows
+     * @param cols Number of board columns
+     * @param startingLength Initial snake length
+     * @param pointsPerFood Points awarded per food
+     * @param initialDirection Starting movement direction
+     */
+    BatchedSnakeEngine(size_t gameCount, int rows, int cols, int startingLength,
+                       int pointsPerFood, Direction initialDirection)
+        : gameCount(gameCount), rows(rows), cols(cols), 
+          cellCount(static_cast<size_t>(rows) * cols), wordCount((cellCount + 63) / 64),
+          startingLength(startingLength),
+          pointsPerFood(pointsPerFood), initialDirection(initialDirection),
+          headRow(gameCount), headCol(gameCount), direction(gameCount), length(gameCount),
+          headSlot(gameCount), tailCell(gameCount), growthPending(gameCount), score(gameCount),
+          foodCell(gameCount), foodPresent(gameCount), done(gameCount, 1), emptyCount(gameCount),
+          rngs(gameCount), boards(gameCount * cellCount), emptyBits(gameCount * wordCount),
+          rings(gameCount * cellCount),
+          nextRow(gameCount), nextCol(gameCount), nextCell(gameCount), cellAhead(gameCount), dies(gameCount), eats(gameCount) {}
+
+    /**
+     * @brief Starts a new game in slot g (SnakeGameLogic::initializeBoard).
+     * @param g Game slot
+     * @param seed RNG seed for food placement
+     */
+    void reset(size_t g, unsigned int seed) {
+        size_t base = g * cellCount;
+        rngs[g].seed(seed);
+        fill(boards.begin() + base, boards.begin() + base + cellCount, EMPTY);
+        uint64_t* words = emptyBits.data() + g * wordCount;
+        fill(words, words + wordCount, ~uint64_t(0));
+        if (cellCount % 64 != 0) {
+            words[wordCount - 1] = (uint64_t(1) << (cellCount % 64)) - 1;
+        }
+        emptyCount[g] = static_cast<uint32_t>(cellCount);
+        
+        score[g] = 0;
+        done[g] = 0;
+        growthPending[g] = 0;
+        direction[g] = static_cast<uint8_t>(initialDirection);
+        headSlot[g] = 0;
+        length[g] = 0;
+        
+        // Snake::initialize
+        int startRow = rows / 2;
+        int startCol = cols / 2;
+        for (int i = 0; i < startingLength; i++) {
+            int r = startRow;
+            int c = startCol;
+            switch (initialDirection) {
+                case RIGHT: c -= i; break;
+                case LEFT:  c += i; break;
+                case UP:    r += i; break;
+                case DOWN:  r -= i; break;
+                case NONE:  break;
+            }
+            if (r < 0 || r >= rows || c < 0 || c >= cols || length[g] == cellCount) break;
+            
+            uint32_t index = static_cast<uint32_t>(r * cols + c);
+            rings[base + length[g]++] = index;
+            setCell(g, index, SNAKE);
+        }
+        headRow[g] = static_cast<int32_t>(rings[base] / cols);
+        headCol[g] = static_cast<int32_t>(rings[base] % cols);
+        tailCell[g] = rings[base + length[g] - 1];
+        
+        placeFood(g);
+    }
+
+    /**
+     * @brief Starts new games in every slot; slot g uses firstSeed + g.
+     * @param firstSeed Seed of slot 0
+     */
+    void resetAll(unsigned int firstSeed) {
+        for (size_t g = 0; g < gameCount; g++) {
+            reset(g, firstSeed + static_cast<unsigned int>(g));
+        }
+    }
+
+    /**
+     * @brief Advances every running game by one tick.
+     * @param actions One Direction per game (NONE keeps the current one), or nullptr
+     * @return Number of games still running after the step
+     */
+    size_t step(const Direction* actions) {
+        size_t n = gameCount;
+        if (actions) {
+            steerAll(n, actions, direction.data());
+        }
+        aimAll(n, rows, cols, direction.data(), headRow.data(), headCol.data(),
+               nextRow.data(), nextCol.data(), nextCell.data(), dies.data());
+        
+        // The board read is a byte gather across games, kept in its own
+        // scalar loop so the checks around it vectorize
+        const CellType* cells = boards.data();
+        size_t stride = cellCount;
+        for (size_t g = 0; g < n; g++) {
+            cellAhead[g] = cells[g * stride + nextCell[g]];
+        }
+        checkAll(n, cellAhead.data(), nextCell.data(), tailCell.data(), growthPending.data(),
+                 foodCell.data(), foodPresent.data(), done.data(), dies.data(), eats.data());
+        
+        // Phase 2: apply moves for games still running
+        size_t running = 0;
+        for (size_t g = 0; g < gameCount; g++) {
+            if (done[g]) continue;
+            if (dies[g]) {
+                done[g] = 1;
+                continue;
+            }
+            
+            size_t base = g * cellCount;
+            if (eats[g]) {
+                growthPending[g]++;
+                score[g] += pointsPerFood;
+                setCell(g, foodCell[g], EMPTY);
+                foodPresent[g] = 0;
+            }
+            
+            // Snake::move
+            if (growthPending[g] > 0) {
+                growthPending[g]--;
+            } else {
+                setCell(g, tailCell[g], EMPTY);
+                length[g]--;
+            }
+            headSlot[g] = headSlot[g] == 0 ? static_cast<uint32_t>(cellCount) - 1 : headSlot[g] - 1;
+            rings[base + headSlot[g]] = nextCell[g];
+            length[g]++;
+            setCell(g, nextCell[g], SNAKE);
+            headRow[g] = nextRow[g];
+            headCol[g] = nextCol[g];
+            tailCell[g] = rings[base + ringSlot(g, length[g] - 1)];
+            
+            if (!foodPresent[g]) {
+                placeFood(g);
+            }
+            
+            // Win condition (board full)
+            if (!foodPresent[g] && growthPending[g] == 0) {
+                done[g] = 1;
+                continue;
+            }
+            running++;
+        }
+        return running;
+    }
+
+    size_t getGameCount() const { return gameCount; }
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+    bool isDone(size_t g) const { return done[g] != 0; }
+    int getScore(size_t g) const { return score[g]; }
+    size_t getLength(size_t g) const { return length[g]; }
+    Direction getDirection(size_t g) const { return static_cast<Direction>(direction[g]); }
+    pair<int, int> getHead(size_t g) const { return {headRow[g], headCol[g]}; }
+    bool hasFood(size_t g) const { return foodPresent[g] != 0; }
+    pair<int, int> getFood(size_t g) const {
+        return {static_cast<int>(foodCell[g] / cols), static_cast<int>(foodCell[g] % cols)};
+    }
+
+    /**
+     * @brief Gets game g's board as a row-major span of rows * cols cells.
+     * @param g Game slot
+     * @return Span over the packed board storage
+     */
+    span<const CellType> getBoard(size_t g) const {
+        return span<const CellType>(boards.data() + g * cellCount, cellCount);
+    }
+};
+
+#endif // BATCHEDENGINE_H
@@ -0,0 +1,434 @@
+#include "gameLogic.h"
+#include "fixedGame.h"
+#include "multiSnake.h"
+#include "batchedEngine.h"
+#include "frameRenderer.h"
+#include "envBatch.h"
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <new>
+
+using namespace std;
+
+// Microbenchmarks for the gameLogic.h hot paths. Each result is one JSON
+// object per line on stdout, so runs can be diffed or loaded by scripts:
+//   {"benchmark":"snake_move","rows":20,"cols":40,"length":3,"iterations":...,"ns_per_op":...,"allocs_per_op":...}
+// allocs_per_op counts global operator new calls in the timed batch, so a
+// steady-state hot path should report 0.
+
+// ============================================
+// Harness
+// ============================================
+
+static double minSeconds = 0.2;
+static volatile uint64_t sink = 0;
+static uint64_t allocationCount = 0;   // Single-threaded benchmarks only
+
+void* operator new(size_t size) {
+    allocationCount++;
+    if (void* block = malloc(size ? size : 1)) return block;
+    throw bad_alloc();
+}
+
+// Out of line, or GCC pairs an inlined free() with the new-expression
+// and warns (-Wmismatched-new-delete)
+[[gnu::noinline]] void operator delete(void* block) noexcept { free(block); }
+[[gnu::noinline]] void operator delete(void* block, size_t) noexcept { free(block); }
+
+// Runs op in growing batches until the batch takes at least minSeconds
+template <typename Op>
+static void runBenchmark(const char* name, int rows, int cols, size_t length, Op&& op) {
+    uint64_t iterations = 1;
+    double elapsed = 0.0;
+    uint64_t allocations = 0;
+    while (true) {
+        uint64_t allocationsBefore = allocationCount;
+        auto start = chrono::steady_clock::now();
+        for (uint64_t i = 0; i < iterations; i++) {
+            op();
+        }
+        elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        allocations = allocationCount - allocationsBefore;
+        if (elapsed >= minSeconds || iterations >= (uint64_t(1) << 40)) break;
+        iterations *= elapsed > 0.0 ? max<uint64_t>(2, static_cast<uint64_t>(minSeconds / elapsed * 1.2)) : 16;
+    }
+    
+    cout << "{\"benchmark\":\"" << name << "\",\"rows\":" << rows << ",\"cols\":" << cols
+         << ",\"length\":" << length << ",\"iterations\":" << iterations
+         << ",\"ns_per_op\":" << elapsed * 1e9 / iterations
+         << ",\"allocs_per_op\":" << static_cast<double>(allocations) / iterations << "}\n";
+    cout.flush();
+}
+
+// ============================================
+// Fixtures
+// ============================================
+
+// Hamiltonian cycle for an even number of rows: even rows run right over
+// columns 1..cols-1, odd rows run back left, and column 0 returns to the
+// top. The centre row is even, so it continues the initial RIGHT snake.
+static vector<pair<int, int>> buildCycle(int rows, int cols) {
+    vector<pair<int, int>> cycle;
+    cycle.reserve(static_cast<size_t>(rows) * cols);
+    for (int r = 0; r < rows; r++) {
+        if (r % 2 == 0) {
+            for (int c = 1; c < cols; c++) cycle.push_back({r, c});
+        } else {
+            for (int c = cols - 1; c >= 1; c--) cycle.push_back({r, c});
+        }
+    }
+    for (int r = rows - 1; r >= 0; r--) cycle.push_back({r, 0});
+    return cycle;
+}
+
+// A board with a snake of the given length laid along the cycle
+struct SnakeFixture {
+    Board board;
+    Snake snake;
+    vector<pair<int, int>> cycle;
+    size_t headOnCycle = 0;
+    
+    SnakeFixture(int rows, int cols, size_t length) {
+        board.initialize(rows, cols);
+        cycle = buildCycle(rows, cols);
+        snake.initialize(cycle[0], 1, RIGHT, board);
+        snake.grow(static_cast<int>(length) - 1);
+        for (size_t i = 1; i < length; i++) {
+            advance();
+        }
+        board.clearChanges();
+    }
+    
+    pair<int, int> nextHead() const {
+        return cycle[(headOnCycle + 1) % cycle.size()];
+    }
+    
+    void advance() {
+        headOnCycle = (headOnCycle + 1) % cycle.size();
+        snake.move(cycle[headOnCycle], board);
+    }
+};
+
+// Directs SnakeGameLogic around the cycle so a game never ends early
+static Direction followCycle(const SnakeGameLogic& game, const vector<size_t>& cycleNext, int cols) {
+    pair<int, int> head = game.getSnake().getHead();
+    size_t next = cycleNext[static_cast<size_t>(head.first) * cols + head.second];
+    int nextRow = static_cast<int>(next / cols);
+    int nextCol = static_cast<int>(next % cols);
+    if (nextRow < head.first) return UP;
+    if (nextRow > head.first) return DOWN;
+    if (nextCol < head.second) return LEFT;
+    return RIGHT;
+}
+
+// Successor of every cell on the benchmark cycle, as flat indices
+static vector<size_t> buildCycleNext(int rows, int cols) {
+    vector<pair<int, int>> cycle = buildCycle(rows, cols);
+    vector<size_t> cycleNext(cycle.size());
+    for (size_t i = 0; i < cycle.size(); i++) {
+        pair<int, int> from = cycle[i];
+        pair<int, int> to = cycle[(i + 1) % cycle.size()];
+        cycleNext[static_cast<size_t>(from.first) * cols + from.second] = 
+            static_cast<size_t>(to.first) * cols + to.second;
+    }
+    return cycleNext;
+}
+
+// ============================================
+// Benchmarks
+// ============================================
+
+static void benchBoard(int rows, int cols, size_t length) {
+    SnakeFixture fixture(rows, cols, length);
+    runBenchmark("board_get_empty_cells", rows, cols, length, [&] {
+        sink = sink + fixture.board.getEmptyCells().size();
+    });
+    
+    GameRng rng;
+    rng.seed(1);
+    FoodManager food(rng);
+    runBenchmark("food_place_random", rows, cols, length, [&] {
+        food.placeRandom(fixture.board);
+        food.remove(fixture.board);
+        fixture.board.clearChanges();
+    });
+}
+
+static void benchSnake(int rows, int cols, size_t length) {
+    SnakeFixture fixture(rows, cols, length);
+    runBenchmark("snake_move", rows, cols, length, [&] {
+        fixture.advance();
+        fixture.board.clearChanges();
+    });
+    
+    // Alternate a free target (next cycle cell) and a body cell
+    bool probeBody = false;
+    runBenchmark("snake_check_self_collision", rows, cols, length, [&] {
+        pair<int, int> target = probeBody ? fixture.snake.getSegment(length / 2) : fixture.nextHead();
+        sink = sink + fixture.snake.checkSelfCollision(target, fixture.board);
+        probeBody = !probeBody;
+    });
+}
+
+static void benchPublish(int rows, int cols, size_t length) {
+    for (bool incremental : {false, true}) {
+        SnakeFixture fixture(rows, cols, length);
+        GameRng rng;
+        rng.seed(1);
+        FoodManager food(rng);
+        StatePublisher publisher;
+        publisher.setIncremental(incremental);
+        publisher.publish(fixture.board, fixture.snake, food, 0, false);
+        runBenchmark(incremental ? "state_publish_incremental" : "state_publish_full", 
+                     rows, cols, length, [&] {
+            fixture.advance();
+            publisher.publish(fixture.board, fixture.snake, food, 0, false);
+            fixture.board.clearChanges();
+        });
+    }
+}
+
+static void benchUpdate(int rows, int cols, size_t length) {
+    vector<size_t> cycleNext = buildCycleNext(rows, cols);
+    
+    for (bool incremental : {false, true}) {
+        SnakeGameLogic game(1);
+        game.setIncrementalPublishing(incremental);
+        game.initializeBoard(rows, cols, static_cast<int>(length), 10, RIGHT);
+        runBenchmark(incremental ? "game_update_incremental" : "game_update_full", 
+                     rows, cols, length, [&] {
+            game.setDirection(followCycle(game, cycleNext, cols));
+            if (!game.update()) {
+                game.initializeBoard(rows, cols, static_cast<int>(length), 10, RIGHT);
+            }
+        });
+    }
+}
+
+// A tick plus the console frame the game would stage for it (deltas into
+// the cache, then the changed cells); the frame is built but not presented
+static void benchRender(int rows, int cols, size_t length) {
+    vector<size_t> cycleNext = buildCycleNext(rows, cols);
+    SnakeGameLogic game(1);
+    game.setIncrementalPublishing(true);
+    game.initializeBoard(rows, cols, static_cast<int>(length), 10, RIGHT);
+    FrameRenderer frame;
+    frame.layout(rows, cols, 4, 6);
+    ConsoleScreen screen;
+    runBenchmark("render_frame", rows, cols, length, [&] {
+        game.setDirection(followCycle(game, cycleNext, cols));
+        if (!game.update()) {
+            game.initializeBoard(rows, cols, static_cast<int>(length), 10, RIGHT);
+        }
+        auto state = game.getGameState();
+        frame.sync(*state);
+        frame.draw(*state, 0, screen);
+        screen.discard();
+    });
+}
+
+// Same walk as game_update_full on the compile-time sized engine, plus the
+// cost of forking a position by copy
+template <int Rows, int Cols>
+static void benchFixed(size_t length) {
+    using Game = FixedSnakeGame<Rows, Cols>;
+    vector<size_t> cycleNext = buildCycleNext(Rows, Cols);
+    Game game;
+    game.reset(1, static_cast<int>(length), 10, RIGHT);
+    runBenchmark("fixed_update", Rows, Cols, length, [&] {
+        pair<int, int> head = game.getHead();
+        pair<int, int> next = Game::toPosition(cycleNext[Game::toIndex(head.first, head.second)]);
+        Direction dir = next.first < head.first ? UP : next.first > head.first ? DOWN
+                      : next.second < head.second ? LEFT : RIGHT;
+        if (!game.step(dir)) {
+            game.reset(1, static_cast<int>(length), 10, RIGHT);
+        }
+    });
+    
+    Game fork;
+    runBenchmark("fixed_fork", Rows, Cols, length, [&] {
+        fork = game;
+        sink = sink + fork.step(UP);
+    });
+}
+
+// One tick of a multiplayer game; each snake keeps going straight and
+// turns only when the cell ahead is taken, so most of them stay alive
+static void benchMulti(int rows, int cols, size_t snakes) {
+    vector<SnakeSpawn> spawns = MultiSnakeGame::spreadSpawns(rows, cols, snakes);
+    MultiSnakeGame game(1);
+    game.initializeBoard(rows, cols, 3, 10, spawns);
+    string name = "multi_update_" + to_string(snakes) + "_snakes";
+    runBenchmark(name.c_str(), rows, cols, 3, [&] {
+        static const int rowStep[] = {-1, 1, 0, 0};
+        static const int colStep[] = {0, 0, -1, 1};
+        static const Direction turns[4][3] = {
+            {UP, LEFT, RIGHT}, {DOWN, RIGHT, LEFT}, {LEFT, DOWN, UP}, {RIGHT, UP, DOWN}};
+        const Board& board = game.getBoard();
+        for (size_t i = 0; i < snakes; i++) {
+            if (!game.isAlive(i)) continue;
+            pair<int, int> head = game.getSnake(i).getHead();
+            for (Direction dir : turns[game.getCurrentDirection(i)]) {
+                int r = head.first + rowStep[dir];
+                int c = head.second + colStep[dir];
+                if (board.isInBounds(r, c) && board.getCellType(r, c) != SNAKE && board.getCellType(r, c) != WALL) {
+                    game.setDirection(i, dir);
+                    break;
+                }
+            }
+        }
+        if (!game.update() || game.getAliveCount() < snakes / 2) {
+            game.initializeBoard(rows, cols, 3, 10, spawns);
+        }
+    });
+}
+
+// One lockstep tick of a whole batch. Every game follows the benchmark
+// cycle from the same start, so all heads move together and one action
+// array serves the batch; divide by the game count for the per-game cost
+static void benchBatched(int rows, int cols, size_t games) {
+    vector<size_t> cycleNext = buildCycleNext(rows, cols);
+    BatchedSnakeEngine engine(games, rows, cols, 3, 10, RIGHT);
+    engine.resetAll(1);
+    vector<Direction> actions(games, RIGHT);
+    string name = "batched_step_" + to_string(games) + "_games";
+    runBenchmark(name.c_str(), rows, cols, 3, [&] {
+        pair<int, int> head = engine.getHead(0);
+        size_t next = cycleNext[static_cast<size_t>(head.first) * cols + head.second];
+        int nextRow = static_cast<int>(next / cols);
+        int nextCol = static_cast<int>(next % cols);
+        Direction direction = nextRow < head.first ? UP : nextRow > head.first ? DOWN
+                            : nextCol < head.second ? LEFT : RIGHT;
+        fill(actions.begin(), actions.end(), direction);
+        if (engine.step(actions.data()) == 0) {
+            engine.resetAll(1);
+        }
+    });
+}
+
+// One step of a training batch with random actions, observations written
+// to float planes; random play dies often, so resets are part of the cost
+static void benchEnv(int rows, int cols, int envs) {
+    SnakeEnvConfig config{};
+    config.envCount = envs;
+    config.rows = rows;
+    config.cols = cols;
+    EnvBatch batch;
+    batch.initialize(config);
+    vector<float> planes(envs * batch.getPlaneSize());
+    vector<float> rewards(envs);
+    vector<uint8_t> dones(envs);
+    SnakeEnvBuffers buffers{};
+    buffers.planes = planes.data();
+    buffers.rewards = rewards.data();
+    buffers.dones = dones.data();
+    batch.bind(buffers);
+    mt19937 rng(1);
+    vector<int32_t> actions(envs);
+    string name = "env_step_" + to_string(envs) + "_envs";
+    runBenchmark(name.c_str(), rows, cols, 3, [&] {
+        for (int32_t& action : actions) action = static_cast<int32_t>(rng() % 4);
+        batch.step(actions.data());
+        sink = sink + dones[0];
+    });
+}
+
+static void benchSerialize(int rows, int cols, size_t length) {
+    SnakeGameLogic game(1);
+    game.setPublishing(false);
+    game.initializeBoard(rows, cols, static_cast<int>(length), 10, RIGHT);
+    SnakeGameLogic copy(1);
+    copy.setPublishing(false);
+    copy.initializeBoard(rows, cols, static_cast<int>(length), 10, RIGHT);
+    vector<uint8_t> buffer(game.getSerializedSize());
+    
+    runBenchmark("game_serialize", rows, cols, length, [&] {
+        sink = sink + game.serialize(buffer);
+    });
+    runBenchmark("game_deserialize", rows, cols, length, [&] {
+        sink = sink + copy.deserialize(buffer);
+    });
+}
+
+static void benchSearch(int rows, int cols, size_t length) {
+    SnakeGameLogic game(1);
+    game.setPublishing(false);
+    game.initializeBoard(rows, cols, static_cast<int>(length), 10, RIGHT);
+    SearchState search;
+    search.reserve(16, 16);
+    game.loadSearchState(search);
+    
+    // Every non-reversing move from the start position, three plies deep
+    static const Direction moves[] = {UP, DOWN, RIGHT};
+    runBenchmark("search_simulate_undo_depth3", rows, cols, length, [&] {
+        for (Direction first : moves) {
+            SnakeGameLogic::simulate(search, first);
+            for (Direction second : moves) {
+                SnakeGameLogic::simulate(search, second);
+                for (Direction third : moves) {
+                    sink = sink + SnakeGameLogic::simulate(search, third);
+                    SnakeGameLogic::undo(search);
+                }
+                SnakeGameLogic::undo(search);
+            }
+            SnakeGameLogic::undo(search);
+        }
+    });
+}
+
+// ============================================
+// Main
+// ============================================
+
+int main(int argc, char** argv) {
+    bool quick = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--quick") == 0) {
+            quick = true;
+        } else if (strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+            minSeconds = atof(argv[++i]);
+        } else {
+            cerr << "Usage: " << argv[0] << " [--quick] [--min-time seconds]\n";
+            return 1;
+        }
+    }
+    
+    // Rows must be even for the benchmark cycle
+    vector<pair<int, int>> sizes = {{20, 40}, {100, 100}, {500, 500}, {1000, 1000}};
+    if (quick) sizes = {{20, 40}, {100, 100}};
+    
+    for (auto [rows, cols] : sizes) {
+        size_t cells = static_cast<size_t>(rows) * cols;
+        vector<size_t> lengths = {3, cells / 10, cells / 2};
+        
+        for (size_t length : lengths) {
+            benchBoard(rows, cols, length);
+            benchSnake(rows, cols, length);
+            benchPublish(rows, cols, length);
+        }
+        
+        // initializeBoard lays the snake along the centre row, which caps its length
+        for (size_t length : {size_t(3), static_cast<size_t>(cols / 2)}) {
+            benchUpdate(rows, cols, length);
+            benchRender(rows, cols, length);
+            if (rows == 20 && cols == 40) benchFixed<20, 40>(length);
+            if (rows == 100 && cols == 100) benchFixed<100, 100>(length);
+            benchSerialize(rows, cols, length);
+            benchSearch(rows, cols, length);
+        }
+        
+        for (size_t snakes : {size_t(1), size_t(16), size_t(256)}) {
+            if (snakes <= static_cast<size_t>(rows)) benchMulti(rows, cols, snakes);
+        }
+        
+        // Observation planes (envs * 4 * cells floats) and batched boards grow
+        // with the board, so only the smaller boards
+        if (cells <= 100 * 100) {
+            for (int envs : {1, 64}) benchEnv(rows, cols, envs);
+            benchBatched(rows, cols, 1024);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,321 @@
+// consoleScreen.h
+#ifndef CONSOLESCREEN_H
+#define CONSOLESCREEN_H
+
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <cerrno>
+    #include <poll.h>
+    #include <sys/ioctl.h>
+    #include <unistd.h>
+#endif
+
+using namespace std;
+
+// ============================================================================
+// CONSOLE SCREEN
+// ============================================================================
+
+/**
+ * @brief Frame-at-a-time console output with one interface on every platform.
+ *
+ * Callers stage text at screen positions with write() and clear(), then
+ * show everything staged with present(), which is a single call to the
+ * console. Nothing is visible before present().
+ *
+ * - Windows: a CHAR_INFO image of the window is kept in memory. present()
+ *   blits the whole image into the hidden one of two screen buffers with
+ *   one WriteConsoleOutput and flips it active (SetConsoleActiveScreenBuffer),
+ *   so there is no tearing, no per-row cursor calls and no "cls" process.
+ *   The game's buffers replace the shell's screen until close().
+ * - POSIX: writes become ANSI cursor moves and text in one reused buffer;
+ *   present() hands it to the terminal with one write(). After the largest
+ *   frame has been staged once, staging never allocates.
+ *
+ * A '\n' in written text continues on the next row at the starting column.
+ */
+class ConsoleScreen {
+private:
+#ifdef _WIN32
+    HANDLE buffers[2] = {INVALID_HANDLE_VALUE, INVALID_HANDLE_VALUE};
+    int back = 1;                    // Buffer present() draws into
+    WORD attributes = FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE;
+    int rows = 0;
+    int cols = 0;
+    vector<CHAR_INFO> cells;         // The next frame, row-major
+    bool changed = false;
+
+    HANDLE activeBuffer() const {
+        return buffers[1 - back] != INVALID_HANDLE_VALUE ? buffers[1 - back] : GetStdHandle(STD_OUTPUT_HANDLE);
+    }
+
+    // Sizes both buffers (and the image) to the console window
+    void fitWindow() {
+        int windowRows = 0, windowCols = 0;
+        if (!getSize(windowRows, windowCols)) return;
+        if (windowRows == rows && windowCols == cols) return;
+        rows = windowRows;
+        cols = windowCols;
+        COORD size = {static_cast<SHORT>(cols), static_cast<SHORT>(rows)};
+        SMALL_RECT window = {0, 0, static_cast<SHORT>(cols - 1), static_cast<SHORT>(rows - 1)};
+        for (HANDLE buffer : buffers) {
+            // The window must fit the buffer at every step, so try both orders
+            if (!SetConsoleScreenBufferSize(buffer, size)) {
+                SetConsoleWindowInfo(buffer, TRUE, &window);
+                SetConsoleScreenBufferSize(buffer, size);
+            }
+            SetConsoleWindowInfo(buffer, TRUE, &window);
+        }
+        CHAR_INFO blank;
+        blank.Char.AsciiChar = ' ';
+        blank.Attributes = attributes;
+        cells.assign(static_cast<size_t>(rows) * cols, blank);
+        changed = true;
+    }
+#else
+    string pending;                  // Staged output, kept allocated between frames
+    bool cursorHidden = false;
+
+    // "ESC[row;colH" into out (at least 26 bytes); returns the end
+    static char* formatMove(char* out, int row, int col) {
+        *out++ = '\033';
+        *out++ = '[';
+        out = to_chars(out, out + 11, row + 1).ptr;
+        *out++ = ';';
+        out = to_chars(out, out + 11, col + 1).ptr;
+        *out++ = 'H';
+        return out;
+    }
+
+    void putMove(int row, int col) {
+        char move[32];
+        pending.append(move, formatMove(move, row, col));
+    }
+
+    void putAll(const char* data, size_t length) {
+        size_t offset = 0;
+        while (offset < length) {
+            ssize_t written = ::write(STDOUT_FILENO, data + offset, length - offset);
+            if (written < 0) {
+                // LINUX FIX: stdout can share stdin's O_NONBLOCK flag on a tty,
+                // so wait for room instead of dropping the rest of a large frame
+                if (errno == EAGAIN) {
+                    pollfd out = {STDOUT_FILENO, POLLOUT, 0};
+                    poll(&out, 1, 100);
+                    continue;
+                }
+                if (errno == EINTR) continue;
+                break;
+            }
+            offset += written;
+        }
+    }
+#endif
+
+public:
+    ConsoleScreen() = default;
+    ConsoleScreen(const ConsoleScreen&) = delete;
+    ConsoleScreen& operator=(const ConsoleScreen&) = delete;
+    ~ConsoleScreen() { close(); }
+
+    /**
+     * @brief Takes over the console (the Windows screen buffers) and hides the cursor.
+     * @return False if there is no console to draw on (Windows only)
+     */
+    bool open() {
+#ifdef _WIN32
+        CONSOLE_SCREEN_BUFFER_INFO info;
+        if (!GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &info)) return false;
+        attributes = info.wAttributes;
+        CONSOLE_CURSOR_INFO cursor = {100, FALSE};
+        for (HANDLE& buffer : buffers) {
+            buffer = CreateConsoleScreenBuffer(GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                                               NULL, CONSOLE_TEXTMODE_BUFFER, NULL);
+            if (buffer == INVALID_HANDLE_VALUE) {
+                close();
+                return false;
+            }
+            SetConsoleCursorInfo(buffer, &cursor);
+        }
+        SetConsoleActiveScreenBuffer(buffers[0]);
+        back = 1;
+        rows = cols = 0;
+        fitWindow();
+#else
+        pending += "\033[?25l";
+        cursorHidden = true;
+        present();
+#endif
+        return true;
+    }
+
+    /**
+     * @brief Gives the console back: the shell's screen buffer on Windows,
+     *        a visible cursor on POSIX. Called by the destructor.
+     */
+    void close() {
+#ifdef _WIN32
+        if (buffers[0] == INVALID_HANDLE_VALUE && buffers[1] == INVALID_HANDLE_VALUE) return;
+        SetConsoleActiveScreenBuffer(GetStdHandle(STD_OUTPUT_HANDLE));
+        for (HANDLE& buffer : buffers) {
+            if (buffer != INVALID_HANDLE_VALUE) CloseHandle(buffer);
+            buffer = INVALID_HANDLE_VALUE;
+        }
+#else
+        if (!cursorHidden) return;
+        pending += "\033[?25h";
+        cursorHidden = false;
+        present();
+#endif
+    }
+
+    /**
+     * @brief Gets the visible window size in character cells.
+     * @param rows Set to the window height
+     * @param cols Set to the window width
+     * @return False if stdout is not a console or terminal
+     */
+    bool getSize(int& rows, int& cols) const {
+#ifdef _WIN32
+        CONSOLE_SCREEN_BUFFER_INFO info;
+        if (!GetConsoleScreenBufferInfo(activeBuffer(), &info)) return false;
+        rows = info.srWindow.Bottom - info.srWindow.Top + 1;
+        cols = info.srWindow.Right - info.srWindow.Left + 1;
+#else
+        winsize size;
+        if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) != 0 || size.ws_row == 0 || size.ws_col == 0) return false;
+        rows = size.ws_row;
+        cols = size.ws_col;
+#endif
+        return true;
+    }
+
+    /**
+     * @brief Blanks the whole screen in the next frame (and, on Windows,
+     *        follows a resized window).
+     */
+    void clear() {
+#ifdef _WIN32
+        fitWindow();
+        for (CHAR_INFO& cell : cells) {
+            cell.Char.AsciiChar = ' ';
+            cell.Attributes = attributes;
+        }
+        changed = true;
+#else
+        // LINUX FIX: Use \033[H\033[J instead of \033[2J\033[1;1H for more reliable clearing
+        pending += "\033[H\033[J";
+#endif
+    }
+
+    /**
+     * @brief Stages text at a screen position; text off the screen is dropped
+     *        on Windows and left to the terminal on POSIX.
+     * @param row Screen row (0-based)
+     * @param col Screen column (0-based)
+     * @param text Characters to show; '\n' moves to the next row at col
+     * @param length Number of characters
+     */
+    void write(int row, int col, const char* text, size_t length) {
+#ifdef _WIN32
+        int c = col;
+        for (size_t i = 0; i < length; i++) {
+            if (text[i] == '\n') {
+                row++;
+                c = col;
+                continue;
+            }
+            if (row >= 0 && row < rows && c >= 0 && c < cols) {
+                CHAR_INFO& cell = cells[static_cast<size_t>(row) * cols + c];
+                cell.Char.AsciiChar = text[i];
+                cell.Attributes = attributes;
+            }
+            c++;
+        }
+        changed = true;
+#else
+        putMove(row, col);
+        for (const char* newline; (newline = static_cast<const char*>(memchr(text, '\n', length)));) {
+            pending.append(text, newline);
+            length -= static_cast<size_t>(newline - text) + 1;
+            text = newline + 1;
+            putMove(++row, col);
+        }
+        pending.append(text, length);
+#endif
+    }
+
+    void write(int row, int col, const string& text) {
+        write(row, col, text.data(), text.size());
+    }
+
+    /**
+     * @brief Stages one character (the per-cell fast path).
+     * @param row Screen row (0-based)
+     * @param col Screen column (0-based)
+     * @param glyph Character to show
+     */
+    void write(int row, int col, char glyph) {
+#ifdef _WIN32
+        if (row < 0 || row >= rows || col < 0 || col >= cols) return;
+        CHAR_INFO& cell = cells[static_cast<size_t>(row) * cols + col];
+        cell.Char.AsciiChar = glyph;
+        cell.Attributes = attributes;
+        changed = true;
+#else
+        char move[32];
+        char* out = formatMove(move, row, col);
+        *out++ = glyph;
+        pending.append(move, out);
+#endif
+    }
+
+    /**
+     * @brief Shows everything staged since the last present() with one console call.
+     */
+    void present() {
+#ifdef _WIN32
+        if (!changed || cells.empty()) return;
+        HANDLE target = buffers[back] != INVALID_HANDLE_VALUE ? buffers[back] : GetStdHandle(STD_OUTPUT_HANDLE);
+        COORD size = {static_cast<SHORT>(cols), static_cast<SHORT>(rows)};
+        SMALL_RECT region = {0, 0, static_cast<SHORT>(cols - 1), static_cast<SHORT>(rows - 1)};
+        WriteConsoleOutputA(target, cells.data(), size, {0, 0}, &region);
+        if (buffers[back] != INVALID_HANDLE_VALUE) {
+            SetConsoleActiveScreenBuffer(target);
+            back = 1 - back;
+        }
+        changed = false;
+#else
+        if (pending.empty()) return;
+        putAll(pending.data(), pending.size());
+        pending.clear();
+#endif
+    }
+
+    /**
+     * @brief Skips presenting what was staged (benchmarks); on Windows the
+     *        image keeps it for the next frame.
+     */
+    void discard() {
+#ifdef _WIN32
+        changed = false;
+#else
+        pending.clear();
+#endif
+    }
+};
+
+#endif // CONSOLESCREEN_H
@@ -0,0 +1,338 @@
+// envBatch.h
+#ifndef ENVBATCH_H
+#define ENVBATCH_H
+
+#include "gameLogic.h"
+#include "snakeEnv.h"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// ============================================================================
+// TRAINING ENVIRONMENT BATCH
+// ============================================================================
+
+/**
+ * @brief Many SnakeGameLogic environments stepped together for RL training,
+ *        writing observations straight into caller-owned arrays.
+ *
+ * This is the engine behind the snakeEnv.h C API and uses its config and
+ * buffer structs. Each environment is a full SnakeGameLogic with state
+ * publishing off, so actions go through the usual DirectionController and
+ * a game plays exactly like SnakeGameLogic(seed).
+ *
+ * Observations are written in place instead of through getGameState():
+ * after reset the environment's planes are cleared and its walls, body and
+ * food drawn once; after a step only the cells in the Board change log and
+ * the old and new head are rewritten (a few cells instead of the board),
+ * falling back to a full redraw when the log overflows.
+ *
+ * With threads > 1, step() splits the environments into one contiguous
+ * range per thread: the caller runs the first range and persistent
+ * workers the others, woken per step through a condition variable. Every
+ * environment has its own game and seed sequence, so results do not
+ * depend on the thread count.
+ */
+class EnvBatch {
+public:
+    static constexpr int PLANES = SNAKE_ENV_PLANES;
+
+private:
+    enum Job { STEP, RESET };
+
+    size_t envCount = 0;
+    int rows = 0;
+    int cols = 0;
+    size_t cellCount = 0;
+    int startingLength = 3;
+    int pointsPerFood = 10;
+    uint32_t maxTicks = 0;
+    vector<CellType> layout;         // Empty when there are no walls
+    vector<uint32_t> wallCells;
+
+    unique_ptr<SnakeGameLogic[]> games;   ///< Not movable (atomics), hence an array
+    vector<uint32_t> nextSeed;       // Seed of each environment's next automatic reset
+    vector<uint32_t> ticks;          // Ticks in the current episode
+    vector<uint32_t> headCell;       // Head as last written to the planes
+    SnakeEnvBuffers buffers{};
+
+    // Worker pool (threads - 1 workers; the caller takes range 0)
+    vector<thread> workers;
+    mutex lock;
+    condition_variable wake;
+    condition_variable finished;
+    uint64_t round = 0;              // Bumped per parallel job, guarded by lock
+    size_t remaining = 0;            // Workers still on the current job
+    bool stopping = false;
+    Job job = STEP;
+    const int32_t* jobActions = nullptr;
+    uint32_t jobSeed = 0;
+
+    void setCellPlanes(size_t env, uint32_t cell, CellType type, bool isHead) {
+        size_t base = env * PLANES * cellCount + cell;
+        bool values[PLANES] = {isHead, type == SNAKE && !isHead, type == FOOD, type == WALL};
+        for (int plane = 0; plane < PLANES; plane++) {
+            if (buffers.planes) buffers.planes[base + plane * cellCount] = values[plane] ? 1.0f : 0.0f;
+            if (buffers.planesU8) buffers.planesU8[base + plane * cellCount] = values[plane];
+        }
+    }
+
+    void writeCoords(size_t env) {
+        if (!buffers.coords) return;
+        float* out = buffers.coords + env * SNAKE_ENV_COORDS;
+        const SnakeGameLogic& game = games[env];
+        pair<int, int> head = game.getSnake().getHead();
+        bool food = game.getFoodManager().isPresent();
+        pair<int, int> position = game.getFoodManager().getPosition();
+        out[0] = static_cast<float>(head.first);
+        out[1] = static_cast<float>(head.second);
+        out[2] = food ? static_cast<float>(position.first) : -1.0f;
+        out[3] = food ? static_cast<float>(position.second) : -1.0f;
+    }
+
+    // Clears the environment's planes and draws walls, body and food
+    void writeAll(size_t env) {
+        SnakeGameLogic& game = games[env];
+        size_t planeSize = PLANES * cellCount;
+        if (buffers.planes) memset(buffers.planes + env * planeSize, 0, planeSize * sizeof(float));
+        if (buffers.planesU8) memset(buffers.planesU8 + env * planeSize, 0, planeSize);
+
+        for (uint32_t cell : wallCells) setCellPlanes(env, cell, WALL, false);
+        const Snake& snake = game.getSnake();
+        uint32_t head = snake.getSegmentIndex(0);
+        auto [first, second] = snake.getBodySpans();
+        for (uint32_t cell : first) setCellPlanes(env, cell, SNAKE, cell == head);
+        for (uint32_t cell : second) setCellPlanes(env, cell, SNAKE, cell == head);
+        const FoodManager& food = game.getFoodManager();
+        if (food.isPresent()) {
+            pair<int, int> position = food.getPosition();
+            setCellPlanes(env, static_cast<uint32_t>(game.getBoard().toIndex(position.first, position.second)),
+                          FOOD, false);
+        }
+
+        headCell[env] = head;
+        writeCoords(env);
+        game.clearBoardChanges();
+    }
+
+    // Rewrites only the cells the last tick changed, plus the old and new head
+    void writeChanges(size_t env) {
+        SnakeGameLogic& game = games[env];
+        const Board& board = game.getBoard();
+        if (board.hasChangeOverflow()) {
+            writeAll(env);
+            return;
+        }
+        uint32_t head = game.getSnake().getSegmentIndex(0);
+        if (buffers.planes || buffers.planesU8) {
+            for (uint32_t cell : board.getChangedCells()) {
+                setCellPlanes(env, cell, board.getCell(cell), cell == head);
+            }
+            setCellPlanes(env, headCell[env], board.getCell(headCell[env]), headCell[env] == head);
+            setCellPlanes(env, head, board.getCell(head), true);
+        }
+        headCell[env] = head;
+        writeCoords(env);
+        game.clearBoardChanges();
+    }
+
+    void resetOne(size_t env, uint32_t seed) {
+        SnakeGameLogic& game = games[env];
+        game.setSeed(seed);
+        game.initializeBoard(rows, cols, startingLength, pointsPerFood, RIGHT,
+                             layout.empty() ? nullptr : layout.data());
+        ticks[env] = 0;
+        writeAll(env);
+    }
+
+    void stepOne(size_t env, int32_t action) {
+        SnakeGameLogic& game = games[env];
+        if (action >= UP && action <= RIGHT) {
+            game.setDirection(static_cast<Direction>(action));
+        }
+        int scoreBefore = game.getLiveScore();
+        bool running = game.update();
+        ticks[env]++;
+
+        float reward = static_cast<float>(game.getLiveScore() - scoreBefore) / pointsPerFood;
+        uint8_t done = SNAKE_ENV_RUNNING;
+        if (!running) {
+            done = SNAKE_ENV_TERMINATED;
+            // A filled board ends with no food left; any other end is a death
+            if (game.getFoodManager().isPresent()) reward -= 1.0f;
+        } else if (ticks[env] >= maxTicks) {
+            done = SNAKE_ENV_TRUNCATED;
+        }
+        if (buffers.rewards) buffers.rewards[env] = reward;
+        if (buffers.dones) buffers.dones[env] = done;
+        if (buffers.scores) buffers.scores[env] = game.getLiveScore();
+
+        if (done != SNAKE_ENV_RUNNING) {
+            resetOne(env, nextSeed[env]);
+            nextSeed[env] += static_cast<uint32_t>(envCount);
+        } else {
+            writeChanges(env);
+        }
+    }
+
+    // Runs the current job on one thread's contiguous range of environments
+    void runRange(size_t part, size_t parts) {
+        size_t begin = envCount * part / parts;
+        size_t end = envCount * (part + 1) / parts;
+        for (size_t env = begin; env < end; env++) {
+            if (job == RESET) {
+                resetOne(env, jobSeed + static_cast<uint32_t>(env));
+                nextSeed[env] = jobSeed + static_cast<uint32_t>(env + envCount);
+                if (buffers.rewards) buffers.rewards[env] = 0.0f;
+                if (buffers.dones) buffers.dones[env] = SNAKE_ENV_RUNNING;
+                if (buffers.scores) buffers.scores[env] = 0;
+            } else {
+                stepOne(env, jobActions ? jobActions[env] : -1);
+            }
+        }
+    }
+
+    void workerLoop(size_t part) {
+        uint64_t seen = 0;
+        unique_lock<mutex> guard(lock);
+        while (true) {
+            wake.wait(guard, [&] { return stopping || round != seen; });
+            if (stopping) return;
+            seen = round;
+            guard.unlock();
+            runRange(part, workers.size() + 1);
+            guard.lock();
+            if (--remaining == 0) finished.notify_one();
+        }
+    }
+
+    void runJob(Job nextJob, const int32_t* actions, uint32_t seed) {
+        if (workers.empty()) {
+            job = nextJob;
+            jobActions = actions;
+            jobSeed = seed;
+            runRange(0, 1);
+            return;
+        }
+        {
+            lock_guard<mutex> guard(lock);
+            job = nextJob;
+            jobActions = actions;
+            jobSeed = seed;
+            remaining = workers.size();
+            round++;
+        }
+        wake.notify_all();
+        runRange(0, workers.size() + 1);
+        unique_lock<mutex> guard(lock);
+        finished.wait(guard, [this] { return remaining == 0; });
+    }
+
+    void stopWorkers() {
+        {
+            lock_guard<mutex> guard(lock);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (thread& worker : workers) worker.join();
+        workers.clear();
+        stopping = false;
+    }
+
+public:
+    EnvBatch() = default;
+    EnvBatch(const EnvBatch&) = delete;
+    EnvBatch& operator=(const EnvBatch&) = delete;
+    ~EnvBatch() { stopWorkers(); }
+
+    /**
+     * @brief Sizes the batch, starts the workers and resets every environment with seed 0.
+     * @param config Batch parameters (zero fields take their defaults)
+     * @return False if the parameters are invalid (no environments, a board
+     *         that cannot hold the snake, or a wall on the centre cell)
+     */
+    bool initialize(const SnakeEnvConfig& config) {
+        stopWorkers();
+        int newRows = config.rows > 0 ? config.rows : 20;
+        int newCols = config.cols > 0 ? config.cols : 40;
+        int newLength = config.startingLength > 0 ? config.startingLength : 3;
+        if (config.envCount <= 0 || newLength > newCols / 2 + 1 ||
+            static_cast<uint64_t>(newRows) * newCols > UINT32_MAX / PLANES) {
+            return false;
+        }
+        size_t centre = static_cast<size_t>(newRows / 2) * newCols + newCols / 2;
+        if (config.walls && config.walls[centre]) return false;
+
+        envCount = static_cast<size_t>(config.envCount);
+        rows = newRows;
+        cols = newCols;
+        cellCount = static_cast<size_t>(rows) * cols;
+        startingLength = newLength;
+        pointsPerFood = config.pointsPerFood > 0 ? config.pointsPerFood : 10;
+        maxTicks = config.maxTicks > 0 ? config.maxTicks : static_cast<uint32_t>(min<uint64_t>(100 * cellCount, UINT32_MAX));
+
+        layout.clear();
+        wallCells.clear();
+        if (config.walls) {
+            layout.assign(cellCount, EMPTY);
+            for (size_t i = 0; i < cellCount; i++) {
+                if (!config.walls[i]) continue;
+                layout[i] = WALL;
+                wallCells.push_back(static_cast<uint32_t>(i));
+            }
+        }
+
+        games = make_unique<SnakeGameLogic[]>(envCount);
+        for (size_t env = 0; env < envCount; env++) {
+            games[env].setPublishing(false);
+        }
+        nextSeed.assign(envCount, 0);
+        ticks.assign(envCount, 0);
+        headCell.assign(envCount, 0);
+        buffers = {};
+
+        size_t threads = static_cast<size_t>(max(config.threads, 1));
+        threads = min(threads, envCount);
+        for (size_t part = 1; part < threads; part++) {
+            workers.emplace_back(&EnvBatch::workerLoop, this, part);
+        }
+        reset(0);
+        return true;
+    }
+
+    /**
+     * @brief Binds the output arrays and writes the current observations into them.
+     * @param outputs Arrays to write on every reset and step (NULL members are skipped)
+     */
+    void bind(const SnakeEnvBuffers& outputs) {
+        buffers = outputs;
+        for (size_t env = 0; env < envCount; env++) {
+            writeAll(env);
+        }
+    }
+
+    /**
+     * @brief Starts a new episode everywhere; environment i uses seed + i.
+     * @param seed Seed of environment 0
+     */
+    void reset(uint32_t seed) {
+        runJob(RESET, nullptr, seed);
+    }
+
+    /**
+     * @brief Advances every environment by one tick (finished ones restart).
+     * @param actions One Direction value per environment, or nullptr to keep going straight
+     */
+    void step(const int32_t* actions) {
+        runJob(STEP, actions, 0);
+    }
+
+    size_t getEnvCount() const { return envCount; }
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+    size_t getPlaneSize() const { return PLANES * cellCount; }
+    size_t getThreadCount() const { return workers.size() + 1; }
+    const SnakeGameLogic& getGame(size_t env) const { return games[env]; }
+};
+
+#endif // ENVBATCH_H
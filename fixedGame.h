@@ -0,0 +1,270 @@
+// fixedGame.h
+#ifndef FIXEDGAME_H
+#define FIXEDGAME_H
+
+#include "gameLogic.h"
+#include <type_traits>
+
+// ============================================================================
+// FIXED-SIZE ENGINE
+// ============================================================================
+
+/**
+ * @brief Single-game engine with the board dimensions fixed at compile time.
+ *
+ * Every array is a std::array sized from Rows and Cols, so bounds checks
+ * and index arithmetic divide and compare by constants, the loops have
+ * known trip counts, and the whole game (board, body ring, empty-cell
+ * plane, RNG and scalars) is one trivially copyable object. Forking a
+ * position for a bot is a plain copy with no allocation. Body cells are
+ * stored as uint16_t when the board has at most 65536 cells.
+ *
+ * Semantics reproduce SnakeGameLogic::update exactly, like
+ * BatchedSnakeEngine: the same input validation (one input per step), the
+ * same bounds, wall, self and food check order, the same tail-vacating rule,
+ * and the same row-major k-th empty cell and GameRng draw for food. A game
+ * reset with seed S evolves bit-for-bit like SnakeGameLogic(S) fed the same
+ * directions. SnakeGameLogic stays the engine for any other board size and
+ * for threaded play with publishing.
+ *
+ * Meant for small boards (the 20x40 default and the like): food placement
+ * scans the plane word by word instead of keeping Board's block counters.
+ */
+template <int Rows, int Cols>
+class FixedSnakeGame {
+public:
+    static_assert(Rows > 0 && Cols > 0, "board needs at least one cell");
+
+    static constexpr int ROWS = Rows;
+    static constexpr int COLS = Cols;
+    static constexpr size_t CELLS = static_cast<size_t>(Rows) * Cols;
+
+    using CellIndex = conditional_t<CELLS <= 65536, uint16_t, uint32_t>;
+
+private:
+    static constexpr size_t WORDS = (CELLS + 63) / 64;
+
+    array<CellType, CELLS> cells;
+    array<uint64_t, WORDS> emptyBits;   ///< Bit i % 64 of word i / 64 is set if cell i is empty
+    array<CellIndex, CELLS> ring;       ///< Body cells, head at headSlot
+    uint32_t headSlot = 0;
+    uint32_t length = 0;
+    uint32_t emptyCount = 0;
+    int growthPending = 0;
+    CellIndex foodCell = 0;
+    bool foodExists = false;
+    bool gameOver = true;
+    Direction direction = NONE;
+    int score = 0;
+    int pointsPerFood = 10;
+    GameRng rng;
+
+    // Board::setCell without the change log
+    void setCell(size_t index, CellType type) {
+        CellType previous = cells[index];
+        if (previous == type) return;
+        cells[index] = type;
+        if (previous == EMPTY || type == EMPTY) {
+            emptyBits[index >> 6] ^= uint64_t(1) << (index & 63);
+            emptyCount += type == EMPTY ? 1 : UINT32_MAX;
+        }
+    }
+
+    // FoodManager::placeRandom
+    void placeFood() {
+        if (emptyCount == 0) {
+            foodExists = false;
+            return;
+        }
+        uniform_int_distribution<size_t> dist(0, emptyCount - 1);
+        size_t rank = dist(rng);
+        size_t word = 0;
+        for (;; word++) {
+            size_t count = Board::countBits(emptyBits[word]);
+            if (rank < count) break;
+            rank -= count;
+        }
+        size_t index = word * 64 + Board::selectBit(emptyBits[word], static_cast<unsigned>(rank));
+        setCell(index, FOOD);
+        foodCell = static_cast<CellIndex>(index);
+        foodExists = true;
+    }
+
+    uint32_t ringSlot(uint32_t segment) const {
+        uint32_t slot = headSlot + segment;
+        return slot < CELLS ? slot : slot - static_cast<uint32_t>(CELLS);
+    }
+
+    void clearBoard() {
+        cells.fill(EMPTY);
+        emptyBits.fill(~uint64_t(0));
+        if (CELLS % 64 != 0) {
+            emptyBits[WORDS - 1] = (uint64_t(1) << (CELLS % 64)) - 1;
+        }
+        emptyCount = static_cast<uint32_t>(CELLS);
+    }
+
+public:
+    /**
+     * @brief Checks if a position is within board boundaries.
+     * @param r Row index
+     * @param c Column index
+     * @return True if position is valid, false otherwise
+     */
+    static constexpr bool isInBounds(int r, int c) {
+        return static_cast<unsigned>(r) < static_cast<unsigned>(Rows) &&
+               static_cast<unsigned>(c) < static_cast<unsigned>(Cols);
+    }
+
+    static constexpr size_t toIndex(int r, int c) { return static_cast<size_t>(r) * Cols + c; }
+
+    static constexpr pair<int, int> toPosition(size_t index) {
+        return {static_cast<int>(index / Cols), static_cast<int>(index % Cols)};
+    }
+
+    /**
+     * @brief Starts a new game (SnakeGameLogic::setSeed plus initializeBoard).
+     * @param seed RNG seed for food placement
+     * @param startingLength Initial snake length
+     * @param pointsPerFood Points awarded per food
+     * @param initialDirection Starting movement direction
+     */
+    void reset(unsigned int seed, int startingLength, int pointsPerFood, Direction initialDirection) {
+        rng.seed(seed);
+        clearBoard();
+        score = 0;
+        this->pointsPerFood = pointsPerFood;
+        gameOver = false;
+        growthPending = 0;
+        direction = initialDirection;
+        headSlot = 0;
+        length = 0;
+
+        // Snake::initialize
+        for (int i = 0; i < startingLength; i++) {
+            int r = Rows / 2;
+            int c = Cols / 2;
+            switch (initialDirection) {
+                case RIGHT: c -= i; break;
+                case LEFT:  c += i; break;
+                case UP:    r += i; break;
+                case DOWN:  r -= i; break;
+                case NONE:  break;
+            }
+            if (!isInBounds(r, c) || length == CELLS) break;
+
+            ring[length++] = static_cast<CellIndex>(toIndex(r, c));
+            setCell(toIndex(r, c), SNAKE);
+        }
+
+        placeFood();
+    }
+
+    /**
+     * @brief Copies a live position, e.g. one saved from a SnakeGameLogic.
+     * @param checkpoint State from SnakeGameLogic::saveCheckpoint()
+     * @return False (state unchanged) if the board is not Rows x Cols
+     */
+    bool load(const GameCheckpoint& checkpoint) {
+        const Board& board = checkpoint.board;
+        if (board.getRows() != Rows || board.getCols() != Cols) return false;
+
+        memcpy(cells.data(), board.data(), CELLS);
+        span<const uint64_t> bits = checkpoint.board.getEmptyBits();
+        copy(bits.begin(), bits.end(), emptyBits.begin());
+        emptyCount = static_cast<uint32_t>(board.getEmptyCount());
+
+        headSlot = 0;
+        length = static_cast<uint32_t>(checkpoint.snake.getLength());
+        for (uint32_t i = 0; i < length; i++) {
+            ring[i] = static_cast<CellIndex>(checkpoint.snake.getSegmentIndex(i));
+        }
+        growthPending = static_cast<int>(checkpoint.snake.getGrowthPending());
+        foodExists = checkpoint.foodExists;
+        foodCell = foodExists ? static_cast<CellIndex>(toIndex(checkpoint.food.first, checkpoint.food.second)) : 0;
+        direction = checkpoint.direction;
+        rng = checkpoint.rng;
+        score = checkpoint.score;
+        pointsPerFood = checkpoint.pointsPerFood;
+        gameOver = checkpoint.gameOver;
+        return true;
+    }
+
+    /**
+     * @brief Advances the game by one tick (SnakeGameLogic::update).
+     * @param input Direction to turn to (NONE or a reversal keeps the current one)
+     * @return False if the game is over after (or before) the tick
+     */
+    bool step(Direction input = NONE) {
+        static constexpr int8_t rowStep[5] = {-1, 1, 0, 0, 0};
+        static constexpr int8_t colStep[5] = {0, 0, -1, 1, 0};
+        static constexpr uint8_t opposite[5] = {DOWN, UP, RIGHT, LEFT, NONE + 1};
+        if (gameOver) return false;
+
+        if (input < NONE && input != opposite[direction]) {
+            direction = input;
+        }
+
+        pair<int, int> head = toPosition(ring[headSlot]);
+        int r = head.first + rowStep[direction];
+        int c = head.second + colStep[direction];
+        if (!isInBounds(r, c)) {
+            gameOver = true;
+            return false;
+        }
+
+        size_t next = toIndex(r, c);
+        CellType cell = cells[next];
+        uint32_t tail = ring[ringSlot(length - 1)];
+        if (cell == WALL || (cell == SNAKE && (growthPending > 0 || next != tail))) {
+            gameOver = true;
+            return false;
+        }
+
+        if (foodExists && next == foodCell) {
+            growthPending++;
+            score += pointsPerFood;
+            setCell(foodCell, EMPTY);
+            foodExists = false;
+        }
+
+        // Snake::move
+        if (growthPending > 0) {
+            growthPending--;
+        } else {
+            setCell(tail, EMPTY);
+            length--;
+        }
+        headSlot = headSlot == 0 ? static_cast<uint32_t>(CELLS) - 1 : headSlot - 1;
+        ring[headSlot] = static_cast<CellIndex>(next);
+        length++;
+        setCell(next, SNAKE);
+
+        if (!foodExists) {
+            placeFood();
+        }
+
+        // Win condition (board full)
+        if (!foodExists && growthPending == 0) {
+            gameOver = true;
+            return false;
+        }
+        return true;
+    }
+
+    CellType getCell(size_t index) const { return cells[index]; }
+    const CellType* data() const { return cells.data(); }
+    size_t getLength() const { return length; }
+    size_t getEmptyCount() const { return emptyCount; }
+    pair<int, int> getHead() const { return toPosition(ring[headSlot]); }
+    uint32_t getSegmentIndex(size_t segment) const { return ring[ringSlot(static_cast<uint32_t>(segment))]; }
+    bool hasFood() const { return foodExists; }
+    pair<int, int> getFood() const { return toPosition(foodCell); }
+    Direction getDirection() const { return direction; }
+    int getScore() const { return score; }
+    bool isGameOver() const { return gameOver; }
+};
+
+static_assert(is_trivially_copyable_v<FixedSnakeGame<20, 40>>, "forking a position must be a plain copy");
+
+#endif // FIXEDGAME_H
@@ -0,0 +1,213 @@
+// frameRenderer.h
+#ifndef FRAMERENDERER_H
+#define FRAMERENDERER_H
+
+#include "gameLogic.h"
+#include "consoleScreen.h"
+#include <charconv>
+
+// ============================================================================
+// FRAME RENDERER
+// ============================================================================
+
+/**
+ * @brief Turns published states into ConsoleScreen writes without allocating.
+ *
+ * layout() builds, once per board size, the whole board box (border and
+ * cell glyphs) as rows of bytes, so a full redraw stores the glyphs in
+ * place and writes each row once. It also sizes the dirty list, and the
+ * score line goes into a fixed buffer through to_chars. After that, sync()
+ * and draw() only store bytes into those buffers and the screen's frame,
+ * so a steady-state frame performs no heap allocation.
+ *
+ * The glyph bytes of the box are also what is on screen, which is what
+ * draw() diffs against: only cells whose glyph changed are written.
+ */
+class FrameRenderer {
+private:
+    static constexpr size_t BOARD_DIVISOR = 8;     ///< More than cells / 8 changes redraw everything
+    static constexpr size_t SCORE_CAPACITY = 96;
+
+    int rows = 0;
+    int cols = 0;
+    int boardTop = 0;                // Screen row of the first board row
+    int scoreRow = 0;
+    vector<char> frame;              // Board box, (rows + 2) rows of cols + 2 bytes
+    char scoreLine[SCORE_CAPACITY];
+    size_t scoreSize = 0;
+    char drawnScore[SCORE_CAPACITY];
+    size_t drawnScoreSize = 0;
+
+    vector<CellType> boardCache;
+    uint64_t cachedGeneration = 0;
+    vector<uint32_t> dirtyCells;     // Cells changed since the last frame
+    bool allDirty = true;            // dirtyCells is incomplete; redraw every cell
+    size_t drawnHead = SIZE_MAX;
+
+    static char cellGlyph(CellType cellType, bool isHead) {
+        switch (cellType) {
+            case EMPTY: return ' ';
+            case SNAKE: return isHead ? 'O' : 'o';
+            case FOOD:  return '*';
+            case WALL:  return '#';
+        }
+        return ' ';
+    }
+
+    static char* putText(char* out, const char* text) {
+        size_t length = strlen(text);
+        memcpy(out, text, length);
+        return out + length;
+    }
+
+    // Right-aligned in width columns, like setw
+    static char* putNumber(char* out, int value, int width) {
+        char digits[16];
+        char* end = to_chars(digits, digits + sizeof(digits), value).ptr;
+        int length = static_cast<int>(end - digits);
+        for (int i = length; i < width; i++) *out++ = ' ';
+        memcpy(out, digits, length);
+        return out + length;
+    }
+
+    char* boxRow(int boxRow) {
+        return frame.data() + static_cast<size_t>(boxRow) * (cols + 2);
+    }
+
+    void formatScore(const GameState& state, int highScore) {
+        char* out = scoreLine;
+        out = putText(out, "  Score: ");
+        out = putNumber(out, state.score, 4);
+        out = putText(out, "  |  Length: ");
+        out = putNumber(out, state.snakeLength, 3);
+        out = putText(out, "  |  High Score: ");
+        out = putNumber(out, highScore, 4);
+        out = putText(out, "  ");
+        scoreSize = static_cast<size_t>(out - scoreLine);
+    }
+
+    void drawCell(size_t index, size_t headIndex, ConsoleScreen& screen) {
+        int r = static_cast<int>(index / cols);
+        int c = static_cast<int>(index % cols);
+        char glyph = cellGlyph(boardCache[index], index == headIndex);
+        char& drawn = boxRow(1 + r)[1 + c];
+        if (glyph == drawn) return;
+        drawn = glyph;
+        screen.write(boardTop + r, 1 + c, glyph);
+    }
+
+    static size_t headIndexOf(const GameState& state) {
+        return static_cast<size_t>(state.snakeHead.first) * state.cols + state.snakeHead.second;
+    }
+
+public:
+    /**
+     * @brief Builds the buffers for a board size (the only allocating call).
+     * @param rows Board rows
+     * @param cols Board columns
+     * @param scoreRow Screen row of the score line
+     * @param boardTop Screen row of the first board row (the border is above it)
+     */
+    void layout(int rows, int cols, int scoreRow, int boardTop) {
+        this->rows = rows;
+        this->cols = cols;
+        this->scoreRow = scoreRow;
+        this->boardTop = boardTop;
+        size_t cells = static_cast<size_t>(rows) * cols;
+
+        frame.assign(static_cast<size_t>(rows + 2) * (cols + 2), ' ');
+        for (int r = 0; r < rows + 2; r++) {
+            bool border = r == 0 || r == rows + 1;
+            char* row = boxRow(r);
+            row[0] = row[cols + 1] = border ? '+' : '|';
+            if (border) memset(row + 1, '-', cols);
+        }
+
+        dirtyCells.clear();
+        dirtyCells.reserve(cells / BOARD_DIVISOR + MAX_CELL_DELTAS + 1);
+        boardCache.assign(cells, EMPTY);
+        cachedGeneration = 0;
+        allDirty = true;
+        drawnHead = SIZE_MAX;
+        drawnScoreSize = 0;
+    }
+
+    /**
+     * @brief Folds a state into the cache: its deltas if it directly follows
+     *        the cached generation, otherwise a copy of the whole board.
+     * @param state Latest published state (same size as the layout)
+     */
+    void sync(const GameState& state) {
+        if (state.generation == cachedGeneration) return;
+
+        if (state.deltasComplete && state.generation == cachedGeneration + 1 && !allDirty) {
+            for (size_t i = 0; i < state.deltaCount; i++) {
+                boardCache[state.deltas[i].index] = state.deltas[i].type;
+                dirtyCells.push_back(state.deltas[i].index);
+            }
+            // Past this many it is cheaper to redraw the whole board
+            if (dirtyCells.size() > boardCache.size() / BOARD_DIVISOR) allDirty = true;
+        } else {
+            memcpy(boardCache.data(), state.board.data(), boardCache.size());
+            allDirty = true;
+        }
+        if (allDirty) dirtyCells.clear();
+        cachedGeneration = state.generation;
+    }
+
+    /**
+     * @brief Stages what brings the screen up to date with a state.
+     *
+     * Normally just the changed cells (and the old and new head), plus the
+     * score line if it changed; after a resync or invalidate(), the whole
+     * board box and score line. The caller presents the screen.
+     * @param state State already passed to sync()
+     * @param highScore High score to show
+     * @param screen Screen to write to
+     */
+    void draw(const GameState& state, int highScore, ConsoleScreen& screen) {
+        size_t headIndex = headIndexOf(state);
+        formatScore(state, highScore);
+        if (scoreSize != drawnScoreSize || memcmp(scoreLine, drawnScore, scoreSize) != 0) {
+            screen.write(scoreRow, 0, scoreLine, scoreSize);
+            memcpy(drawnScore, scoreLine, scoreSize);
+            drawnScoreSize = scoreSize;
+        }
+
+        if (allDirty) {
+            for (int r = 0; r < rows; r++) {
+                char* out = boxRow(1 + r) + 1;
+                const CellType* cells = boardCache.data() + static_cast<size_t>(r) * cols;
+                for (int c = 0; c < cols; c++) {
+                    out[c] = cellGlyph(cells[c], static_cast<size_t>(r) * cols + c == headIndex);
+                }
+            }
+            for (int r = 0; r < rows + 2; r++) {
+                screen.write(boardTop - 1 + r, 0, boxRow(r), static_cast<size_t>(cols) + 2);
+            }
+        } else {
+            for (uint32_t index : dirtyCells) {
+                drawCell(index, headIndex, screen);
+            }
+            if (drawnHead < boardCache.size()) drawCell(drawnHead, headIndex, screen);
+            if (headIndex < boardCache.size()) drawCell(headIndex, headIndex, screen);
+        }
+        dirtyCells.clear();
+        allDirty = false;
+        drawnHead = headIndex;
+    }
+
+    /**
+     * @brief Forgets what is on screen, so the next draw() writes everything.
+     */
+    void invalidate() {
+        allDirty = true;
+        dirtyCells.clear();
+        drawnScoreSize = 0;
+    }
+
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+};
+
+#endif // FRAMERENDERER_H
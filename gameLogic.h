@@ -6,33 +6,24 @@
 #define NOMINMAX
 
 #include <iostream>
-#include <deque>
 #include <vector>
 #include <random>
 #include <atomic>
 #include <memory>
 #include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <array>
+#include <bit>
 
-using namespace std;
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
 
-/**
- * @brief Immutable snapshot of the game state at a specific point in time.
- * 
- * This structure is designed to be thread-safe when accessed through
- * shared_ptr with proper memory ordering. All fields are copied from
- * the game logic state during publishing.
- */
-struct GameState {
-    vector<vector<int>> board;      ///< 2D grid representing the game board
-    int rows;                        ///< Number of rows in the board
-    int cols;                        ///< Number of columns in the board
-    int score;                       ///< Current game score
-    bool gameOver;                   ///< Game over flag
-    pair<int, int> food;            ///< Current food position
-    bool foodExists;                 ///< Whether food is present on the board
-    deque<pair<int, int>> snake;    ///< Snake body segments
-    int snakeLength;                 ///< Current length of the snake
-};
+#include "latencyProfiler.h"
+
+using namespace std;
 
 // ============================================================================
 // FORWARD DECLARATIONS
@@ -61,14 +52,87 @@ enum Direction {
 
 /**
  * @brief Represents different types of cells on the game board.
+ *
+ * Stored as a single byte so a whole board is one compact row-major buffer.
  */
-enum CellType { 
+enum CellType : uint8_t { 
     EMPTY = 0, 
     SNAKE = 1, 
     FOOD = 2, 
     WALL = 3 
 };
 
+// ============================================================================
+// GAME STATE SNAPSHOT
+// ============================================================================
+
+/// Most cell changes a single tick can report as deltas (a tick touches ~4)
+constexpr size_t MAX_CELL_DELTAS = 16;
+
+/**
+ * @brief A single board cell change between two consecutive generations.
+ */
+struct CellDelta {
+    uint32_t index;                  ///< Flat row-major cell index
+    CellType type;                   ///< Cell type after the change
+};
+
+/**
+ * @brief Immutable snapshot of the game state at a specific point in time.
+ * 
+ * This structure is designed to be thread-safe when accessed through
+ * a StateHandle, which keeps the buffer from being rewritten while held.
+ * All fields are copied from the game logic state during publishing.
+ *
+ * Each snapshot also carries its generation and the cell deltas from the
+ * previous generation. A reader that saw generation - 1 can apply the deltas
+ * to its own copy; otherwise (or if deltasComplete is false) it should
+ * resync from board, which is always complete.
+ */
+struct GameState {
+    uint64_t generation;             ///< Publish counter, starts at 1
+    array<CellDelta, MAX_CELL_DELTAS> deltas; ///< Cell changes since generation - 1
+    size_t deltaCount;               ///< Number of valid entries in deltas
+    bool deltasComplete;             ///< False if deltas do not cover the change
+    vector<CellType> board;          ///< Row-major board cells (rows * cols)
+    int rows;                        ///< Number of rows in the board
+    int cols;                        ///< Number of columns in the board
+    int score;                       ///< Current game score
+    bool gameOver;                   ///< Game over flag
+    pair<int, int> food;            ///< Current food position
+    bool foodExists;                 ///< Whether food is present on the board
+    vector<uint32_t> snake;          ///< Snake body as flat board indices, head first (empty in incremental mode)
+    pair<int, int> snakeHead;        ///< Current head position
+    int snakeLength;                 ///< Current length of the snake
+
+    /**
+     * @brief Gets the cell at a position using the board's row-major layout.
+     * @param r Row index (must be in bounds)
+     * @param c Column index (must be in bounds)
+     * @return CellType at the position
+     */
+    CellType cellAt(int r, int c) const {
+        return board[static_cast<size_t>(r) * cols + c];
+    }
+
+    /**
+     * @brief Gets the position of a snake segment.
+     * @param segment Segment index (0 is the head)
+     * @return Position of the segment
+     */
+    pair<int, int> snakeSegment(size_t segment) const {
+        return {static_cast<int>(snake[segment] / cols), static_cast<int>(snake[segment] % cols)};
+    }
+};
+
+/**
+ * @brief Journal entry letting Board::rollback() undo one setCell() exactly.
+ */
+struct CellUndo {
+    uint32_t index;                  ///< Flat index of the changed cell
+    CellType type;                   ///< Its type before the change
+};
+
 // ============================================================================
 // BOARD MANAGEMENT
 // ============================================================================
@@ -79,23 +143,205 @@ enum CellType {
  * Provides a clean interface for board manipulation including cell access,
  * modification, and initialization. This class encapsulates all board-related
  * logic and provides boundary checking.
+ *
+ * Cells live in one contiguous row-major buffer (index = r * cols + c), so
+ * lookups are a single indirection and snapshots copy with one memcpy.
+ *
+ * Empty cells are additionally tracked in a bit plane, 64 cells per word,
+ * with a running popcount per block of BLOCK_WORDS words. setCell flips one
+ * bit and one counter; picking the k-th empty cell skips whole blocks, then
+ * whole words by popcount, then selects the bit inside the word (pdep where
+ * BMI2 is available). That costs 1/8 byte per cell instead of the 8 bytes of
+ * an index-based free list, and empty cells are always numbered in
+ * row-major order, so the pick depends only on the board's contents.
  */
 class Board {
 private:
-    vector<vector<int>> grid;
-    int rows;
-    int cols;
+    static constexpr size_t BLOCK_WORDS = 64;
+    static constexpr size_t BLOCK_SHIFT = 12;   ///< log2(64 * BLOCK_WORDS) cells per block
+
+    vector<CellType> grid;
+    vector<uint64_t> emptyBits;     ///< Bit i % 64 of word i / 64 is set if cell i is empty
+    vector<uint32_t> blockEmpty;    ///< Empty cells per block of BLOCK_WORDS words
+    size_t emptyCount = 0;
+    vector<uint32_t> changedCells;  ///< Cells changed since clearChanges()
+    bool changeOverflow = true;     ///< More changes than changedCells can hold
+    vector<CellUndo>* journal = nullptr; ///< Undo log for lookahead search, if attached
+    int rows = 0;
+    int cols = 0;
+
+    /**
+     * @brief Updates the empty-cell plane for a cell whose type is changing.
+     * @param index Flat index of the cell
+     * @param previous Type before the change
+     * @param next Type after the change
+     */
+    void trackEmpty(size_t index, CellType previous, CellType next) {
+        if (previous != EMPTY && next != EMPTY) return;
+        bool nowEmpty = next == EMPTY;
+        emptyBits[index >> 6] ^= uint64_t(1) << (index & 63);
+        blockEmpty[index >> BLOCK_SHIFT] += nowEmpty ? 1 : UINT32_MAX;
+        emptyCount += nowEmpty ? 1 : SIZE_MAX;
+    }
+
+    /**
+     * @brief Sizes the empty-cell plane and its counters for cellCount cells.
+     * @param cellCount Number of board cells
+     */
+    void resizePlane(size_t cellCount) {
+        emptyBits.resize((cellCount + 63) / 64);
+        blockEmpty.resize((emptyBits.size() + BLOCK_WORDS - 1) / BLOCK_WORDS);
+    }
+
+    /**
+     * @brief Recomputes the block counters and total from the plane.
+     */
+    void recountEmpty() {
+        emptyCount = 0;
+        for (size_t block = 0; block < blockEmpty.size(); block++) {
+            size_t end = min(emptyBits.size(), (block + 1) * BLOCK_WORDS);
+            uint32_t count = 0;
+            for (size_t w = block * BLOCK_WORDS; w < end; w++) {
+                count += countBits(emptyBits[w]);
+            }
+            blockEmpty[block] = count;
+            emptyCount += count;
+        }
+    }
+
+    /**
+     * @brief Reads 32 packed cells (8 bytes, low cells first) into a word.
+     * @param packed Source bytes in writePacked() form
+     * @param bytes Bytes available (8 or fewer; missing ones read as 0)
+     * @return Cell i at bits 2i and 2i + 1
+     */
+    static uint64_t loadPacked(const uint8_t* packed, size_t bytes = 8) {
+        uint8_t copy[8] = {};
+        if (bytes < 8) {
+            memcpy(copy, packed, bytes);
+            packed = copy;
+        }
+        uint64_t word = 0;
+        if constexpr (endian::native == endian::little) {
+            memcpy(&word, packed, 8);
+        } else {
+            for (int k = 0; k < 8; k++) word |= static_cast<uint64_t>(packed[k]) << (8 * k);
+        }
+        return word;
+    }
+
+    /**
+     * @brief Marks the 2-bit fields of a packed word that equal type.
+     * @return The low bit of each matching field set
+     */
+    static uint64_t matchPacked(uint64_t word, CellType type) {
+        uint64_t diff = word ^ (0x5555555555555555ULL * type);
+        return ~(diff | (diff >> 1)) & 0x5555555555555555ULL;
+    }
+
+    /**
+     * @brief Gathers the even bits of a word (one per packed cell) into its low 32 bits.
+     */
+    static uint64_t compressEven(uint64_t bits) {
+        bits = (bits | (bits >> 1)) & 0x3333333333333333ULL;
+        bits = (bits | (bits >> 2)) & 0x0F0F0F0F0F0F0F0FULL;
+        bits = (bits | (bits >> 4)) & 0x00FF00FF00FF00FFULL;
+        bits = (bits | (bits >> 8)) & 0x0000FFFF0000FFFFULL;
+        return (bits | (bits >> 16)) & 0x00000000FFFFFFFFULL;
+    }
 
 public:
+    /**
+     * @brief Counts the set bits of a word.
+     * 
+     * Without a popcnt target GCC lowers popcount() to a libgcc call, so
+     * the SWAR sum is inlined instead.
+     * @param word Bit set
+     * @return Number of set bits
+     */
+    static unsigned countBits(uint64_t word) {
+#if defined(__POPCNT__) || defined(_MSC_VER)
+        return static_cast<unsigned>(popcount(word));
+#else
+        word = word - ((word >> 1) & 0x5555555555555555ULL);
+        word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+        word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+        return static_cast<unsigned>((word * 0x0101010101010101ULL) >> 56);
+#endif
+    }
+
+    /**
+     * @brief Finds the position of the k-th set bit of a word.
+     * @param word Bit set with more than k bits
+     * @param k Zero-based rank of the bit
+     * @return Bit position in [0, 64)
+     */
+    static unsigned selectBit(uint64_t word, unsigned k) {
+#if defined(__BMI2__)
+        return static_cast<unsigned>(countr_zero(_pdep_u64(uint64_t(1) << k, word)));
+#else
+        // Halve down to a byte by popcount, then clear the low bits off it
+        unsigned base = 0;
+        for (unsigned half = 32; half >= 8; half /= 2) {
+            uint64_t low = word & ((uint64_t(1) << half) - 1);
+            unsigned count = countBits(low);
+            if (k >= count) {
+                k -= count;
+                word >>= half;
+                base += half;
+            } else {
+                word = low;
+            }
+        }
+        for (; k > 0; k--) {
+            word &= word - 1;
+        }
+        return base + static_cast<unsigned>(countr_zero(word));
+#endif
+    }
+
     /**
      * @brief Initializes the board with specified dimensions.
      * @param rows Number of rows
      * @param cols Number of columns
+     * @param layout Optional row-major rows * cols cells to start from (e.g. a
+     *        mapped level); WALL cells become walls and every other value an
+     *        empty cell. nullptr starts with an empty board
      */
-    void initialize(int rows, int cols) {
+    void initialize(int rows, int cols, const CellType* layout = nullptr) {
         this->rows = rows;
         this->cols = cols;
-        grid = vector<vector<int>>(rows, vector<int>(cols, EMPTY));
+        size_t cellCount = static_cast<size_t>(rows) * cols;
+        resizePlane(cellCount);
+        
+        if (layout) {
+            // One pass, 64 cells per plane word, no branches on cell values
+            grid.resize(cellCount);
+            CellType* cells = grid.data();
+            for (size_t w = 0; w < emptyBits.size(); w++) {
+                size_t end = min(cellCount, (w + 1) * 64);
+                uint64_t bits = 0;
+                for (size_t i = w * 64; i < end; i++) {
+                    bool wall = layout[i] == WALL;
+                    cells[i] = wall ? WALL : EMPTY;
+                    bits |= static_cast<uint64_t>(!wall) << (i & 63);
+                }
+                emptyBits[w] = bits;
+            }
+        } else {
+            // Every cell starts empty; the last word only covers the real cells
+            grid.assign(cellCount, EMPTY);
+            fill(emptyBits.begin(), emptyBits.end(), ~uint64_t(0));
+            if (cellCount % 64 != 0) {
+                emptyBits.back() = (uint64_t(1) << (cellCount % 64)) - 1;
+            }
+        }
+        recountEmpty();
+        
+        // A fresh board is a wholesale change
+        changedCells.clear();
+        changedCells.reserve(MAX_CELL_DELTAS);
+        changeOverflow = true;
     }
 
     /**
@@ -108,15 +354,34 @@ public:
         return r >= 0 && r < rows && c >= 0 && c < cols;
     }
 
+    /**
+     * @brief Converts a position to its flat row-major index.
+     * @param r Row index (must be in bounds)
+     * @param c Column index (must be in bounds)
+     * @return Flat index into the cell buffer
+     */
+    size_t toIndex(int r, int c) const {
+        return static_cast<size_t>(r) * cols + c;
+    }
+
+    /**
+     * @brief Converts a flat index back to a (row, col) position.
+     * @param index Flat index into the cell buffer
+     * @return Position of the cell
+     */
+    pair<int, int> toPosition(size_t index) const {
+        return {static_cast<int>(index / cols), static_cast<int>(index % cols)};
+    }
+
     /**
      * @brief Gets the cell type at specified position.
      * @param r Row index
      * @param c Column index
      * @return CellType at the position
      */
-    int getCellType(int r, int c) const {
+    CellType getCellType(int r, int c) const {
         if (!isInBounds(r, c)) return WALL;
-        return grid[r][c];
+        return grid[toIndex(r, c)];
     }
 
     /**
@@ -125,31 +390,257 @@ public:
      * @param c Column index
      * @param cellType Type to set
      */
-    void setCellType(int r, int c, int cellType) {
+    void setCellType(int r, int c, CellType cellType) {
         if (isInBounds(r, c)) {
-            grid[r][c] = cellType;
+            setCell(toIndex(r, c), cellType);
         }
     }
 
+    /**
+     * @brief Gets the cell type at a flat index (no bounds check).
+     * @param index Flat index into the cell buffer
+     * @return CellType at the index
+     */
+    CellType getCell(size_t index) const { return grid[index]; }
+
+    /**
+     * @brief Sets the cell type at a flat index (no bounds check).
+     * @param index Flat index into the cell buffer
+     * @param cellType Type to set
+     */
+    void setCell(size_t index, CellType cellType) {
+        CellType previous = grid[index];
+        if (previous == cellType) return;
+        
+        if (journal) {
+            journal->push_back({static_cast<uint32_t>(index), previous});
+        }
+        grid[index] = cellType;
+        trackEmpty(index, previous, cellType);
+        
+        if (changedCells.size() < MAX_CELL_DELTAS) {
+            changedCells.push_back(static_cast<uint32_t>(index));
+        } else {
+            changeOverflow = true;
+        }
+    }
+
+    /**
+     * @brief Attaches an undo journal that every following setCell() appends to.
+     * @param journal Journal to append to, or nullptr to stop journaling
+     */
+    void setJournal(vector<CellUndo>* journal) {
+        this->journal = journal;
+    }
+
+    /**
+     * @brief Undoes journaled changes newest first, down to a mark.
+     * 
+     * Must not be journaling while rolling back.
+     * @param entries Journal written while attached
+     * @param mark Journal size to roll back to
+     */
+    void rollback(vector<CellUndo>& entries, size_t mark) {
+        while (entries.size() > mark) {
+            CellUndo undo = entries.back();
+            entries.pop_back();
+            trackEmpty(undo.index, grid[undo.index], undo.type);
+            grid[undo.index] = undo.type;
+        }
+        invalidateChanges();
+    }
+
+    /**
+     * @brief Gets the cells changed since the last clearChanges().
+     * 
+     * May contain duplicates; read the current value with getCell().
+     * Only meaningful when hasChangeOverflow() is false.
+     * @return Span of flat cell indices
+     */
+    span<const uint32_t> getChangedCells() const { return changedCells; }
+
+    /**
+     * @brief Checks if more cells changed than the change log can describe.
+     * @return True if readers must resync the whole board
+     */
+    bool hasChangeOverflow() const { return changeOverflow; }
+
+    /**
+     * @brief Forces the next publish to resync readers from the full board.
+     */
+    void invalidateChanges() {
+        changedCells.clear();
+        changeOverflow = true;
+    }
+
+    /**
+     * @brief Resets the change log (called after each publish).
+     */
+    void clearChanges() {
+        changedCells.clear();
+        changeOverflow = false;
+    }
+
+    /**
+     * @brief Gets the number of empty cells (O(1)).
+     * @return Count of empty cells on the board
+     */
+    size_t getEmptyCount() const { return emptyCount; }
+
+    /**
+     * @brief Checks whether no empty cell is left (O(1)).
+     * @return True if every cell is snake, food or wall
+     */
+    bool isFull() const { return emptyCount == 0; }
+
+    /**
+     * @brief Gets the k-th empty cell in row-major order.
+     * 
+     * Skips whole blocks and then whole words by popcount, so the cost is
+     * about cells / 4096 + 64 additions however full the board is.
+     * @param rank Rank in [0, getEmptyCount())
+     * @return Flat index of the empty cell
+     */
+    size_t getEmptyCell(size_t rank) const {
+        size_t block = 0;
+        while (rank >= blockEmpty[block]) {
+            rank -= blockEmpty[block++];
+        }
+        size_t word = block * BLOCK_WORDS;
+        for (;; word++) {
+            size_t count = countBits(emptyBits[word]);
+            if (rank < count) break;
+            rank -= count;
+        }
+        return word * 64 + selectBit(emptyBits[word], static_cast<unsigned>(rank));
+    }
+
+    /**
+     * @brief Gets the empty-cell bit plane, 64 cells per word.
+     * 
+     * Bit i % 64 of word i / 64 is set if cell i is empty; bits past the
+     * last cell are clear.
+     * @return Span of (cells + 63) / 64 words
+     */
+    span<const uint64_t> getEmptyBits() const { return emptyBits; }
+
     /**
      * @brief Gets all empty cell positions on the board.
+     * 
+     * Walks the bit plane, so fully occupied words cost one test.
      * @return Vector of empty cell coordinates
      */
     vector<pair<int, int>> getEmptyCells() const {
         vector<pair<int, int>> emptyCells;
-        for (int r = 0; r < rows; r++) {
-            for (int c = 0; c < cols; c++) {
-                if (grid[r][c] == EMPTY) {
-                    emptyCells.push_back({r, c});
-                }
+        emptyCells.reserve(emptyCount);
+        for (size_t w = 0; w < emptyBits.size(); w++) {
+            for (uint64_t bits = emptyBits[w]; bits != 0; bits &= bits - 1) {
+                emptyCells.push_back(toPosition(w * 64 + static_cast<size_t>(countr_zero(bits))));
             }
         }
         return emptyCells;
     }
 
+    /**
+     * @brief Gets the size of the board packed at 2 bits per cell.
+     * @return Number of bytes written by writePacked()
+     */
+    size_t getPackedSize() const { return (grid.size() + 3) / 4; }
+
+    /**
+     * @brief Writes the cells at 2 bits each, four cells per byte, low bits first.
+     * @param out Destination of getPackedSize() bytes
+     */
+    void writePacked(uint8_t* out) const {
+        size_t whole = grid.size() / 4;
+        const CellType* cells = grid.data();
+        for (size_t i = 0; i < whole; i++, cells += 4) {
+            out[i] = static_cast<uint8_t>(cells[0] | (cells[1] << 2) | (cells[2] << 4) | (cells[3] << 6));
+        }
+        if (whole < getPackedSize()) {
+            out[whole] = 0;
+            for (size_t i = whole * 4; i < grid.size(); i++) {
+                out[whole] |= static_cast<uint8_t>(grid[i] << (2 * (i % 4)));
+            }
+        }
+    }
+
+    /**
+     * @brief Replaces the board with cells written by writePacked().
+     * 
+     * Storage is reused when the dimensions are unchanged, and the change
+     * log reports an overflow so readers resync.
+     * @param rows Number of rows
+     * @param cols Number of columns
+     * @param packed Source of (rows * cols + 3) / 4 bytes
+     */
+    void readPacked(int rows, int cols, const uint8_t* packed) {
+        this->rows = rows;
+        this->cols = cols;
+        size_t cellCount = static_cast<size_t>(rows) * cols;
+        grid.resize(cellCount);
+        resizePlane(cellCount);
+        
+        // Four cells per byte through a table, then the empty plane straight
+        // from the packed words (32 cells each), not cell by cell
+        static constexpr auto unpack = [] {
+            array<array<CellType, 4>, 256> table{};
+            for (int byte = 0; byte < 256; byte++) {
+                for (int k = 0; k < 4; k++) table[byte][k] = static_cast<CellType>((byte >> (2 * k)) & 3);
+            }
+            return table;
+        }();
+        CellType* cells = grid.data();
+        size_t whole = cellCount / 4;
+        for (size_t i = 0; i < whole; i++) {
+            memcpy(cells + 4 * i, unpack[packed[i]].data(), 4);
+        }
+        for (size_t i = whole * 4; i < cellCount; i++) {
+            cells[i] = unpack[packed[whole]][i % 4];
+        }
+        
+        size_t packedSize = (cellCount + 3) / 4;
+        for (size_t w = 0; w < emptyBits.size(); w++) {
+            uint64_t halves[2];
+            for (size_t h = 0; h < 2; h++) {
+                size_t offset = w * 16 + h * 8;
+                size_t bytes = offset < packedSize ? min<size_t>(8, packedSize - offset) : 0;
+                halves[h] = compressEven(matchPacked(loadPacked(packed + offset, bytes), EMPTY));
+            }
+            emptyBits[w] = halves[0] | (halves[1] << 32);
+        }
+        if (cellCount % 64 != 0) {
+            emptyBits.back() &= (uint64_t(1) << (cellCount % 64)) - 1;
+        }
+        recountEmpty();
+        invalidateChanges();
+    }
+
+    /**
+     * @brief Counts the cells of each type in writePacked() output, 32 at a time.
+     * @param packed Packed cells
+     * @param cellCount Number of cells packed
+     * @param counts Set to the number of cells of each CellType, indexed by type
+     */
+    static void countPacked(const uint8_t* packed, size_t cellCount, size_t counts[4]) {
+        size_t words = cellCount / 32;
+        size_t rest = cellCount % 32;
+        counts[EMPTY] = counts[SNAKE] = counts[FOOD] = 0;
+        for (size_t w = 0; w <= words; w++) {
+            if (w == words && rest == 0) break;
+            uint64_t word = w < words ? loadPacked(packed + 8 * w) : loadPacked(packed + 8 * w, (rest + 3) / 4);
+            uint64_t valid = w < words ? ~uint64_t(0) : (uint64_t(1) << (2 * rest)) - 1;
+            counts[EMPTY] += countBits(matchPacked(word, EMPTY) & valid);
+            counts[SNAKE] += countBits(matchPacked(word, SNAKE) & valid);
+            counts[FOOD] += countBits(matchPacked(word, FOOD) & valid);
+        }
+        counts[WALL] = cellCount - counts[EMPTY] - counts[SNAKE] - counts[FOOD];
+    }
+
     int getRows() const { return rows; }
     int getCols() const { return cols; }
-    const vector<vector<int>>& getGrid() const { return grid; }
+    size_t getCellCount() const { return grid.size(); }
+    const CellType* data() const { return grid.data(); }
 };
 
 // ============================================================================
@@ -162,14 +653,30 @@ public:
  * Encapsulates all snake-related behavior including body segment tracking,
  * movement mechanics, and growth logic. Provides a clean interface for
  * snake operations.
+ *
+ * The body is a ring buffer of flat board indices (head first) sized to the
+ * board's cell count at initialize, so move and grow never allocate. A
+ * uint32_t index keeps boards beyond 65535 cells addressable.
  */
 class Snake {
 private:
-    deque<pair<int, int>> body;
+    vector<uint32_t> ring;
+    size_t headSlot;
+    size_t length;
+    int cols;
     int growthPending;
 
+    size_t slotOf(size_t segment) const {
+        size_t slot = headSlot + segment;
+        return slot < ring.size() ? slot : slot - ring.size();
+    }
+
+    pair<int, int> toPosition(uint32_t index) const {
+        return {static_cast<int>(index / cols), static_cast<int>(index % cols)};
+    }
+
 public:
-    Snake() : growthPending(0) {}
+    Snake() : headSlot(0), length(0), cols(1), growthPending(0) {}
 
     /**
      * @brief Initializes the snake at a starting position.
@@ -179,7 +686,10 @@ public:
      * @param board Reference to the game board
      */
     void initialize(pair<int, int> startPos, int length, Direction direction, Board& board) {
-        body.clear();
+        ring.assign(board.getCellCount(), 0);
+        headSlot = 0;
+        this->length = 0;
+        cols = board.getCols();
         growthPending = 0;
         
         int startRow = startPos.first;
@@ -197,7 +707,11 @@ public:
                 case NONE:  break;
             }
             
-            body.push_back({r, c});
+            // Segments that would start off the board (or on a wall or another
+            // snake) cannot be laid
+            if (!board.isInBounds(r, c) || board.getCellType(r, c) != EMPTY || this->length == ring.size()) break;
+            
+            ring[this->length++] = static_cast<uint32_t>(board.toIndex(r, c));
             board.setCellType(r, c, SNAKE);
         }
     }
@@ -208,18 +722,37 @@ public:
      * @param board Reference to the game board
      */
     void move(pair<int, int> newHead, Board& board) {
-        body.push_front(newHead);
-        board.setCellType(newHead.first, newHead.second, SNAKE);
-        
+        // Vacate the tail before claiming the head so a head moving into
+        // the old tail cell leaves it marked SNAKE
+        vacateTail(board);
+        advanceHead(static_cast<uint32_t>(board.toIndex(newHead.first, newHead.second)), board);
+    }
+
+    /**
+     * @brief First half of move(): uses up one pending growth or frees the tail.
+     * @param board Reference to the game board
+     */
+    void vacateTail(Board& board) {
         if (growthPending > 0) {
             growthPending--;
         } else {
-            pair<int, int> tail = body.back();
-            body.pop_back();
-            board.setCellType(tail.first, tail.second, EMPTY);
+            board.setCell(ring[slotOf(length - 1)], EMPTY);
+            length--;
         }
     }
 
+    /**
+     * @brief Second half of move(): claims the new head cell.
+     * @param index Flat board index of the new head
+     * @param board Reference to the game board
+     */
+    void advanceHead(uint32_t index, Board& board) {
+        headSlot = headSlot == 0 ? ring.size() - 1 : headSlot - 1;
+        ring[headSlot] = index;
+        length++;
+        board.setCell(index, SNAKE);
+    }
+
     /**
      * @brief Adds growth to the snake.
      * @param amount Amount of segments to grow
@@ -229,23 +762,153 @@ public:
     }
 
     /**
-     * @brief Checks if a position collides with the snake body.
-     * @param pos Position to check
+     * @brief Checks if moving the head to a position collides with the body.
+     * 
+     * Resolved with a single board lookup. The tail cell is not solid when
+     * it will vacate on this move (no growth pending), so the snake may
+     * follow its own tail.
+     * @param pos Position the head will move to
+     * @param board Reference to the game board
      * @return True if collision detected, false otherwise
      */
-    bool checkSelfCollision(pair<int, int> pos) const {
-        for (size_t i = 1; i < body.size(); i++) {
-            if (body[i] == pos) return true;
-        }
-        return false;
+    bool checkSelfCollision(pair<int, int> pos, const Board& board) const {
+        if (board.getCellType(pos.first, pos.second) != SNAKE) return false;
+        return growthPending > 0 || pos != getTail();
     }
 
-    pair<int, int> getHead() const { return body.front(); }
-    const deque<pair<int, int>>& getBody() const { return body; }
-    size_t getLength() const { return body.size(); }
+    /**
+     * @brief Exposes the body (head first) as at most two contiguous spans.
+     * 
+     * The second span is empty unless the body wraps around the end of the
+     * ring buffer.
+     * @return Pair of spans of flat board indices
+     */
+    pair<span<const uint32_t>, span<const uint32_t>> getBodySpans() const {
+        size_t firstCount = min(length, ring.size() - headSlot);
+        return {span<const uint32_t>(ring.data() + headSlot, firstCount),
+                span<const uint32_t>(ring.data(), length - firstCount)};
+    }
+
+    /**
+     * @brief Starts rebuilding the body from saved data; the board is left untouched.
+     * @param board Board the snake lives on (already holding its SNAKE cells)
+     * @param growthPending Pending growth to restore
+     */
+    void beginRestore(const Board& board, int growthPending) {
+        ring.resize(board.getCellCount());
+        headSlot = 0;
+        length = 0;
+        cols = board.getCols();
+        this->growthPending = growthPending;
+    }
+
+    /**
+     * @brief Appends the next segment (head first) while restoring.
+     * @param index Flat board index of the segment
+     */
+    void appendSegment(uint32_t index) {
+        ring[length++] = index;
+    }
+
+    /**
+     * @brief Body bookkeeping needed to undo one move().
+     */
+    struct UndoPoint {
+        size_t headSlot;
+        size_t length;
+        int growthPending;
+        uint32_t overwritten;        ///< Ring entry the next head will replace
+    };
+
+    /**
+     * @brief Captures the state to return to after the next move().
+     * @return Undo point for restore()
+     */
+    UndoPoint getUndoPoint() const {
+        size_t nextSlot = headSlot == 0 ? ring.size() - 1 : headSlot - 1;
+        return {headSlot, length, growthPending, ring[nextSlot]};
+    }
+
+    /**
+     * @brief Undoes move() and grow() calls back to an undo point (body only;
+     *        the board is rolled back separately).
+     * @param point Value of getUndoPoint() before the moves
+     */
+    void restore(const UndoPoint& point) {
+        // Rewriting the entry is harmless if no move happened
+        ring[point.headSlot == 0 ? ring.size() - 1 : point.headSlot - 1] = point.overwritten;
+        headSlot = point.headSlot;
+        length = point.length;
+        growthPending = point.growthPending;
+    }
+
+    uint32_t getSegmentIndex(size_t segment) const { return ring[slotOf(segment)]; }
+    int getGrowthPending() const { return growthPending; }
+    pair<int, int> getSegment(size_t segment) const { return toPosition(ring[slotOf(segment)]); }
+    pair<int, int> getHead() const { return getSegment(0); }
+    pair<int, int> getTail() const { return getSegment(length - 1); }
+    size_t getLength() const { return length; }
     bool hasPendingGrowth() const { return growthPending > 0; }
 };
 
+// ============================================================================
+// RANDOM NUMBER GENERATION
+// ============================================================================
+
+/**
+ * @brief Counter-based generator whose whole state is its seed and draw count.
+ * 
+ * Draw n of seed s is SplitMix64's finalizer applied to mix(s) + n * gamma
+ * (SplitMix64 started from mix(s)), so the state is 12 bytes with no hidden
+ * engine behind it. A serialized game stores exactly that; restore() and
+ * copies (checkpoints, search undo) are O(1) no matter how far the stream
+ * has advanced, and any draw count from a blob is a valid state.
+ */
+class GameRng {
+private:
+    static constexpr uint64_t GAMMA = 0x9E3779B97F4A7C15ull;
+    static constexpr uint32_t DEFAULT_SEED = 5489;
+
+    uint64_t key = mix(DEFAULT_SEED);             // mix(seedValue), the stream's start
+    uint32_t seedValue = DEFAULT_SEED;
+    uint64_t draws = 0;
+
+    static constexpr uint64_t mix(uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+public:
+    using result_type = uint32_t;
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT32_MAX; }
+
+    result_type operator()() {
+        draws++;
+        return static_cast<result_type>(mix(key + draws * GAMMA) >> 32);
+    }
+
+    void seed(uint32_t seed) {
+        restore(seed, 0);
+    }
+
+    /**
+     * @brief Moves the generator to the state after a number of draws from a seed.
+     * @param seed Seed of the stream
+     * @param drawCount Draws already taken from the stream
+     */
+    void restore(uint32_t seed, uint64_t drawCount) {
+        key = mix(seed);
+        seedValue = seed;
+        draws = drawCount;
+    }
+
+    uint32_t getSeed() const { return seedValue; }
+    uint64_t getDraws() const { return draws; }
+};
+
 // ============================================================================
 // FOOD MANAGEMENT
 // ============================================================================
@@ -260,34 +923,45 @@ class FoodManager {
 private:
     pair<int, int> position;
     bool exists;
-    mt19937& rng;
+    GameRng& rng;
 
 public:
     /**
      * @brief Constructs a food manager with a random number generator.
      * @param rng Reference to random number generator
      */
-    FoodManager(mt19937& rng) : exists(false), rng(rng) {}
+    FoodManager(GameRng& rng) : exists(false), rng(rng) {}
 
     /**
      * @brief Places food at a random empty location on the board.
      * @param board Reference to the game board
      */
     void placeRandom(Board& board) {
-        vector<pair<int, int>> emptyCells = board.getEmptyCells();
-        
-        if (emptyCells.empty()) {
+        size_t index = pickEmptyCell(board, rng);
+        if (index == SIZE_MAX) {
             exists = false;
             return;
         }
         
-        uniform_int_distribution<int> dist(0, emptyCells.size() - 1);
-        int idx = dist(rng);
-        position = emptyCells[idx];
-        board.setCellType(position.first, position.second, FOOD);
+        position = board.toPosition(index);
+        board.setCell(index, FOOD);
         exists = true;
     }
 
+    /**
+     * @brief Draws the cell placeRandom() would use.
+     * @param board Game board
+     * @param rng Random number generator (advanced only if a cell is empty)
+     * @return Flat index of a uniformly random empty cell, or SIZE_MAX if none
+     */
+    static size_t pickEmptyCell(const Board& board, GameRng& rng) {
+        size_t emptyCount = board.getEmptyCount();
+        if (emptyCount == 0) return SIZE_MAX;
+        
+        uniform_int_distribution<size_t> dist(0, emptyCount - 1);
+        return board.getEmptyCell(dist(rng));
+    }
+
     /**
      * @brief Removes the current food from the board.
      * @param board Reference to the game board
@@ -299,6 +973,16 @@ public:
         }
     }
 
+    /**
+     * @brief Restores food state saved from another game (board already holds the cell).
+     * @param position Food position
+     * @param exists Whether food is present
+     */
+    void restore(pair<int, int> position, bool exists) {
+        this->position = position;
+        this->exists = exists;
+    }
+
     pair<int, int> getPosition() const { return position; }
     bool isPresent() const { return exists; }
 };
@@ -355,16 +1039,27 @@ public:
  * 
  * Ensures direction changes follow game rules (e.g., cannot reverse 180 degrees).
  * Provides thread-safe direction updates through atomic operations.
+ *
+ * Inputs go through a bounded single-producer/single-consumer ring so that
+ * several keys pressed within one tick are applied on consecutive ticks
+ * instead of collapsing to the last one. The producer (input thread) is
+ * wait-free; when the ring is full the newest input is dropped.
  */
 class DirectionController {
 private:
+    static constexpr uint32_t INPUT_CAPACITY = 8;   ///< Power of two
+
     Direction current;
     Direction next;
-    atomic<int> atomicInput;
+    array<Direction, INPUT_CAPACITY> pendingInputs;
+    atomic<uint32_t> inputWriteIndex;   ///< Advanced only by the producer
+    atomic<uint32_t> inputReadIndex;    ///< Advanced only by the consumer
 
 public:
     DirectionController() : current(NONE), next(NONE) {
-        atomicInput.store(static_cast<int>(NONE), memory_order_relaxed);
+        pendingInputs.fill(NONE);
+        inputWriteIndex.store(0, memory_order_relaxed);
+        inputReadIndex.store(0, memory_order_relaxed);
     }
 
     /**
@@ -381,23 +1076,39 @@ public:
     }
 
     /**
-     * @brief Sets the next direction (thread-safe).
+     * @brief Queues a direction change (thread-safe, wait-free producer).
      * @param dir Direction to set
      */
     void setInput(Direction dir) {
-        atomicInput.store(static_cast<int>(dir), memory_order_release);
+        if (dir == NONE) return;
+        uint32_t write = inputWriteIndex.load(memory_order_relaxed);
+        uint32_t read = inputReadIndex.load(memory_order_acquire);
+        if (write - read >= INPUT_CAPACITY) return;
+        
+        pendingInputs[write % INPUT_CAPACITY] = dir;
+        inputWriteIndex.store(write + 1, memory_order_release);
     }
 
     /**
      * @brief Processes input and updates current direction.
+     * 
+     * Applies at most one queued change per tick. Entries that would not
+     * change the direction this tick (a reversal or the current direction)
+     * are discarded so the next real turn is not delayed by them.
      */
     void processInput() {
-        int dirValue = atomicInput.exchange(static_cast<int>(NONE), memory_order_acquire);
-        Direction inputDir = static_cast<Direction>(dirValue);
+        uint32_t read = inputReadIndex.load(memory_order_relaxed);
+        uint32_t write = inputWriteIndex.load(memory_order_acquire);
         
-        if (inputDir != NONE && isValidChange(inputDir)) {
-            next = inputDir;
+        while (read != write) {
+            Direction inputDir = pendingInputs[read % INPUT_CAPACITY];
+            read++;
+            if (inputDir != current && isValidChange(inputDir)) {
+                next = inputDir;
+                break;
+            }
         }
+        inputReadIndex.store(read, memory_order_release);
         
         current = next;
     }
@@ -421,9 +1132,14 @@ public:
         return {newRow, newCol};
     }
 
+    /**
+     * @brief Resets the direction and discards queued input (consumer side).
+     * @param initialDir Starting direction
+     */
     void initialize(Direction initialDir) {
         current = initialDir;
         next = initialDir;
+        inputReadIndex.store(inputWriteIndex.load(memory_order_acquire), memory_order_release);
     }
 
     Direction getCurrent() const { return current; }
@@ -433,23 +1149,144 @@ public:
 // STATE PUBLISHER
 // ============================================================================
 
+/**
+ * @brief Read handle to a published GameState snapshot.
+ * 
+ * Keeps its buffer pinned so the publisher never writes into it while the
+ * handle is alive. Move-only; release by letting it go out of scope.
+ */
+class StateHandle {
+private:
+    const GameState* state;
+    atomic<uint32_t>* pin;
+
+public:
+    StateHandle(const GameState* state, atomic<uint32_t>* pin) : state(state), pin(pin) {}
+    StateHandle(StateHandle&& other) noexcept : state(other.state), pin(other.pin) {
+        other.pin = nullptr;
+    }
+    StateHandle(const StateHandle&) = delete;
+    StateHandle& operator=(const StateHandle&) = delete;
+    StateHandle& operator=(StateHandle&& other) noexcept {
+        if (this != &other) {
+            if (pin) pin->fetch_sub(1, memory_order_release);
+            state = other.state;
+            pin = other.pin;
+            other.pin = nullptr;
+        }
+        return *this;
+    }
+    ~StateHandle() {
+        if (pin) pin->fetch_sub(1, memory_order_release);
+    }
+
+    const GameState* operator->() const { return state; }
+    const GameState& operator*() const { return *state; }
+    const GameState* get() const { return state; }
+};
+
 /**
  * @brief Manages thread-safe publishing of game state snapshots.
  * 
- * Uses double buffering and atomic operations to provide lock-free
- * state updates between game logic and rendering threads.
+ * Snapshots live in a fixed pool of preallocated buffers. Readers pin the
+ * current buffer with a per-buffer counter and the writer only fills a
+ * buffer that is neither current nor pinned, so a snapshot is never
+ * mutated under a reader and publishing never allocates once buffers
+ * have reached board size. Both sides use plain atomic integers, making
+ * the exchange lock-free where those are (see isLockFree()).
+ *
+ * The pool holds enough buffers for the current snapshot plus two held
+ * by readers at once (e.g. a frame's state and a transient accessor call).
+ * If readers pin more, the writer skips the generation rather than block;
+ * consumers of deltas then see a gap and resync from the board.
+ *
+ * Every generation's cell deltas are kept in a short history. In
+ * incremental mode a buffer is brought up to date by replaying the deltas
+ * it missed instead of copying the whole board, and the snake body is not
+ * copied at all, so publishing costs O(1) per tick. A full copy is only
+ * made when the buffer lags past the history or a generation overflowed.
  */
 class StatePublisher {
 private:
-    atomic<shared_ptr<const GameState>> currentState;
-    shared_ptr<GameState> writeBuffer;
-    shared_ptr<GameState> readBuffer;
+    static constexpr size_t DELTA_HISTORY = 8;
+    static constexpr uint32_t BUFFER_COUNT = 4;
+
+    struct DeltaFrame {
+        array<CellDelta, MAX_CELL_DELTAS> deltas;
+        size_t count = 0;
+        bool complete = false;
+    };
+
+    array<GameState, BUFFER_COUNT> buffers{};
+    mutable array<atomic<uint32_t>, BUFFER_COUNT> pins{};
+    atomic<uint32_t> current{0};
+    array<DeltaFrame, DELTA_HISTORY> history;
+    uint64_t generation = 0;
+    bool incremental = false;
+
+    /**
+     * @brief Picks the freshest buffer that is neither current nor pinned.
+     * @return Buffer index, or BUFFER_COUNT if all are in use
+     */
+    uint32_t acquireWriteBuffer() const {
+        uint32_t published = current.load(memory_order_seq_cst);
+        uint32_t chosen = BUFFER_COUNT;
+        for (uint32_t i = 0; i < BUFFER_COUNT; i++) {
+            if (i == published || pins[i].load(memory_order_seq_cst) != 0) continue;
+            if (chosen == BUFFER_COUNT || buffers[i].generation > buffers[chosen].generation) {
+                chosen = i;
+            }
+        }
+        return chosen;
+    }
+
+    /**
+     * @brief Brings a buffer's board up to the current generation.
+     * @param out Buffer being written
+     * @param board Game board
+     */
+    void syncBoard(GameState& out, const Board& board) {
+        uint64_t lag = generation - out.generation;
+        bool canReplay = out.board.size() == board.getCellCount() && lag <= DELTA_HISTORY;
+        for (uint64_t g = out.generation + 1; canReplay && g <= generation; g++) {
+            canReplay = history[g % DELTA_HISTORY].complete;
+        }
+        
+        if (!canReplay) {
+            // Board is a flat byte buffer: resize is a no-op after the first
+            // publish, leaving a single memcpy of rows * cols bytes
+            out.board.resize(board.getCellCount());
+            memcpy(out.board.data(), board.data(), board.getCellCount());
+            return;
+        }
+        
+        for (uint64_t g = out.generation + 1; g <= generation; g++) {
+            const DeltaFrame& frame = history[g % DELTA_HISTORY];
+            for (size_t i = 0; i < frame.count; i++) {
+                out.board[frame.deltas[i].index] = frame.deltas[i].type;
+            }
+        }
+    }
 
 public:
-    StatePublisher() {
-        writeBuffer = make_shared<GameState>();
-        readBuffer = make_shared<GameState>();
-        currentState.store(writeBuffer, memory_order_relaxed);
+    StatePublisher() = default;
+    StatePublisher(const StatePublisher&) = delete;
+    StatePublisher& operator=(const StatePublisher&) = delete;
+
+    /**
+     * @brief Checks whether publishing and reading are lock-free on this platform.
+     * @return True if the atomics used for the buffer exchange are lock-free
+     */
+    static constexpr bool isLockFree() {
+        return atomic<uint32_t>::is_always_lock_free;
+    }
+
+    /**
+     * @brief Enables or disables incremental (delta-based) publishing.
+     * @param enabled True to skip full board and body copies
+     */
+    void setIncremental(bool enabled) {
+        incremental = enabled;
     }
 
     /**
@@ -462,30 +1299,141 @@ public:
      */
     void publish(const Board& board, const Snake& snake, const FoodManager& foodManager, 
                  int score, bool gameOver) {
-        writeBuffer->rows = board.getRows();
-        writeBuffer->cols = board.getCols();
-        writeBuffer->score = score;
-        writeBuffer->gameOver = gameOver;
-        writeBuffer->food = foodManager.getPosition();
-        writeBuffer->foodExists = foodManager.isPresent();
-        writeBuffer->snake = snake.getBody();
-        writeBuffer->snakeLength = snake.getLength();
-        writeBuffer->board = board.getGrid();
+        PROFILE_SCOPE(PROBE_PUBLISH);
+        generation++;
+        DeltaFrame& frame = history[generation % DELTA_HISTORY];
+        frame.count = 0;
+        frame.complete = !board.hasChangeOverflow();
+        if (frame.complete) {
+            for (uint32_t index : board.getChangedCells()) {
+                frame.deltas[frame.count++] = {index, board.getCell(index)};
+            }
+        }
+        
+        uint32_t target = acquireWriteBuffer();
+        if (target == BUFFER_COUNT) return;
+        GameState& out = buffers[target];
+        
+        out.rows = board.getRows();
+        out.cols = board.getCols();
+        out.score = score;
+        out.gameOver = gameOver;
+        out.food = foodManager.getPosition();
+        out.foodExists = foodManager.isPresent();
+        out.snakeHead = snake.getHead();
+        out.snakeLength = snake.getLength();
+        out.deltas = frame.deltas;
+        out.deltaCount = frame.count;
+        out.deltasComplete = frame.complete;
+        
+        if (incremental) {
+            syncBoard(out, board);
+            out.snake.clear();
+        } else {
+            out.board.resize(board.getCellCount());
+            memcpy(out.board.data(), board.data(), board.getCellCount());
+            
+            // Reserve the longest possible body once so growth never reallocates;
+            // the body arrives as one or two contiguous ring spans
+            auto [front, back] = snake.getBodySpans();
+            out.snake.reserve(board.getCellCount());
+            out.snake.resize(front.size() + back.size());
+            copy(front.begin(), front.end(), out.snake.begin());
+            copy(back.begin(), back.end(), out.snake.begin() + front.size());
+        }
+        out.generation = generation;
         
-        // Atomic swap with memory_order_release ensures visibility
-        currentState.store(writeBuffer, memory_order_release);
-        swap(writeBuffer, readBuffer);
+        // seq_cst pairs with the reader's pin-then-recheck in getState()
+        current.store(target, memory_order_seq_cst);
     }
 
     /**
      * @brief Gets the current game state (thread-safe).
-     * @return Shared pointer to immutable game state
+     * 
+     * Pins the current buffer, then re-checks it is still current; a
+     * concurrent publish can only cause a retry, never a torn read.
+     * @return Handle to immutable game state
      */
-    shared_ptr<const GameState> getState() const {
-        return currentState.load(memory_order_acquire);
+    StateHandle getState() const {
+        while (true) {
+            uint32_t index = current.load(memory_order_seq_cst);
+            pins[index].fetch_add(1, memory_order_seq_cst);
+            if (current.load(memory_order_seq_cst) == index) {
+                return StateHandle(&buffers[index], &pins[index]);
+            }
+            pins[index].fetch_sub(1, memory_order_release);
+        }
     }
 };
 
+// ============================================================================
+// CHECKPOINTS
+// ============================================================================
+
+/**
+ * @brief Full copy of the live game state, for seeking and rewinding.
+ * 
+ * Everything update() reads is captured, including the RNG, so a restored
+ * game continues tick-for-tick like the original. Queued input is not part
+ * of the state. Saving into the same checkpoint again reuses its storage.
+ */
+struct GameCheckpoint {
+    Board board;
+    Snake snake;
+    pair<int, int> food;
+    bool foodExists = false;
+    Direction direction = NONE;
+    GameRng rng;
+    int score = 0;
+    int pointsPerFood = 0;
+    bool gameOver = false;
+};
+
+/**
+ * @brief A game state for lookahead search, stepped by SnakeGameLogic::simulate().
+ * 
+ * Holds a checkpoint of the game plus an undo log, so a search can walk a
+ * tree of moves depth-first: simulate() a move, recurse, undo(). Each move
+ * journals its few cell changes and scalar state, making undo O(1), and
+ * neither call publishes state. Only moves that place food also save the RNG.
+ * Logs grow to the deepest line searched and are reused after that.
+ */
+class SearchState {
+private:
+    friend class SnakeGameLogic;
+
+    struct MoveUndo {
+        size_t cellMark;
+        Snake::UndoPoint snake;
+        pair<int, int> food;
+        bool foodExists;
+        bool placedFood;
+        Direction direction;
+        int score;
+        bool gameOver;
+    };
+
+    GameCheckpoint state;
+    vector<MoveUndo> moves;
+    vector<CellUndo> cellLog;
+    vector<GameRng> rngLog;
+
+public:
+    /**
+     * @brief Reserves undo logs so moves never allocate.
+     * @param depth Deepest line of moves that will be simulated
+     * @param meals Most food placements along one line (each saves the RNG)
+     */
+    void reserve(size_t depth, size_t meals) {
+        moves.reserve(depth);
+        cellLog.reserve(depth * 4);
+        rngLog.reserve(meals);
+    }
+
+    const GameCheckpoint& get() const { return state; }
+    size_t getDepth() const { return moves.size(); }
+};
+
 // ============================================================================
 // MAIN GAME LOGIC
 // ============================================================================
@@ -501,21 +1449,83 @@ class SnakeGameLogic {
 private:
     Board board;
     Snake snake;
+    GameRng rng;                     // Before foodManager, which keeps a reference to it
     FoodManager foodManager;
     DirectionController directionController;
     StatePublisher statePublisher;
     
-    mt19937 rng;
     int score;
     int pointsPerFood;
     bool gameOver;
+    bool publishingEnabled;
+    vector<uint64_t> bodySeen;       // deserialize()'s visited-cell bits, kept for reuse
+
+    /**
+     * @brief Publishes the current state and resets the board change log.
+     * 
+     * With publishing disabled the change log keeps accumulating, so the
+     * next publishNow() still reports correct deltas (or an overflow).
+     */
+    void publishState() {
+        if (!publishingEnabled) return;
+        statePublisher.publish(board, snake, foodManager, score, gameOver);
+        board.clearChanges();
+    }
+
+    static constexpr uint8_t SERIAL_VERSION = 2;   // 2: counter-based GameRng
+    static constexpr size_t SERIAL_HEADER_SIZE = 48;
+
+    static void putU32(uint8_t* out, uint32_t value) {
+        for (int i = 0; i < 4; i++) out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+
+    static uint32_t getU32(const uint8_t* in) {
+        return in[0] | (in[1] << 8) | (in[2] << 16) | (static_cast<uint32_t>(in[3]) << 24);
+    }
+
+    /**
+     * @brief Follows one delta-encoded body step.
+     * @param index Flat index of the current segment
+     * @param step Direction to the next segment
+     * @param rows Number of board rows
+     * @param cols Number of board columns
+     * @return Flat index of the next segment, or UINT32_MAX if it leaves the board
+     */
+    static uint32_t stepIndex(uint32_t index, uint8_t step, uint32_t rows, uint32_t cols) {
+        uint32_t r = index / cols;
+        uint32_t c = index % cols;
+        switch (step) {
+            case UP:    return r > 0 ? index - cols : UINT32_MAX;
+            case DOWN:  return r + 1 < rows ? index + cols : UINT32_MAX;
+            case LEFT:  return c > 0 ? index - 1 : UINT32_MAX;
+            default:    return c + 1 < cols ? index + 1 : UINT32_MAX;
+        }
+    }
 
 public:
-    SnakeGameLogic() : foodManager(rng), score(0), pointsPerFood(10), gameOver(false) {
+    SnakeGameLogic() : foodManager(rng), score(0), pointsPerFood(10), gameOver(false),
+                       publishingEnabled(true) {
         auto seed = chrono::high_resolution_clock::now().time_since_epoch().count();
         rng.seed(static_cast<unsigned int>(seed));
     }
 
+    /**
+     * @brief Constructs a game with a fixed RNG seed for reproducible runs.
+     * @param seed Seed for food placement
+     */
+    explicit SnakeGameLogic(unsigned int seed) 
+        : foodManager(rng), score(0), pointsPerFood(10), gameOver(false), publishingEnabled(true) {
+        rng.seed(seed);
+    }
+
+    /**
+     * @brief Reseeds the RNG; takes effect from the next food placement.
+     * @param seed Seed for food placement
+     */
+    void setSeed(unsigned int seed) {
+        rng.seed(seed);
+    }
+
     /**
      * @brief Initializes the game with specified parameters.
      * @param rows Number of board rows
@@ -523,21 +1533,343 @@ public:
      * @param startingLength Initial snake length
      * @param pointsPerFood Points awarded per food
      * @param initialDirection Starting movement direction
+     * @param layout Optional wall layout of rows * cols cells (see
+     *        Board::initialize); the centre cell, where the head starts,
+     *        must not be a wall
      */
     void initializeBoard(int rows, int cols, int startingLength, 
-                        int pointsPerFood, Direction initialDirection) {
+                        int pointsPerFood, Direction initialDirection,
+                        const CellType* layout = nullptr) {
         this->pointsPerFood = pointsPerFood;
         score = 0;
         gameOver = false;
         
-        board.initialize(rows, cols);
+        board.initialize(rows, cols, layout);
         directionController.initialize(initialDirection);
         
         pair<int, int> startPos = {rows / 2, cols / 2};
         snake.initialize(startPos, startingLength, initialDirection, board);
         
         foodManager.placeRandom(board);
+        publishState();
+    }
+
+    /**
+     * @brief Copies the live game state into a checkpoint.
+     * @param checkpoint Destination; its buffers are reused when already sized
+     */
+    void saveCheckpoint(GameCheckpoint& checkpoint) const {
+        checkpoint.board = board;
+        checkpoint.snake = snake;
+        checkpoint.food = foodManager.getPosition();
+        checkpoint.foodExists = foodManager.isPresent();
+        checkpoint.direction = directionController.getCurrent();
+        checkpoint.rng = rng;
+        checkpoint.score = score;
+        checkpoint.pointsPerFood = pointsPerFood;
+        checkpoint.gameOver = gameOver;
+    }
+
+    /**
+     * @brief Restores a checkpoint, discarding queued input.
+     * 
+     * The next publish is a full resync, since the checkpoint's board is
+     * unrelated to the previous generation.
+     * @param checkpoint State saved by saveCheckpoint()
+     */
+    void restoreCheckpoint(const GameCheckpoint& checkpoint) {
+        board = checkpoint.board;
+        board.invalidateChanges();
+        snake = checkpoint.snake;
+        foodManager.restore(checkpoint.food, checkpoint.foodExists);
+        directionController.initialize(checkpoint.direction);
+        rng = checkpoint.rng;
+        score = checkpoint.score;
+        pointsPerFood = checkpoint.pointsPerFood;
+        gameOver = checkpoint.gameOver;
+        publishState();
+    }
+
+    // ========================================================================
+    // LOOKAHEAD SEARCH
+    // ========================================================================
+
+    /**
+     * @brief Starts a search from the live game state, clearing its undo logs.
+     * @param search State to load (storage is reused)
+     */
+    void loadSearchState(SearchState& search) const {
+        saveCheckpoint(search.state);
+        search.moves.clear();
+        search.cellLog.clear();
+        search.rngLog.clear();
+    }
+
+    /**
+     * @brief Plays one tick on a search state and logs how to undo it.
+     * 
+     * Follows update() exactly, with dir standing in for that tick's queued
+     * input (NONE, a reversal or the current direction keep going straight),
+     * but never publishes. Stepping a finished game logs a no-op move so
+     * every simulate() still pairs with one undo().
+     * @param search Search state to advance
+     * @param dir Input for this tick
+     * @return True if the game continues, false if it is over
+     */
+    static bool simulate(SearchState& search, Direction dir) {
+        GameCheckpoint& game = search.state;
+        search.moves.push_back({search.cellLog.size(), game.snake.getUndoPoint(), game.food,
+                                game.foodExists, false, game.direction, game.score, game.gameOver});
+        if (game.gameOver) return false;
+        
+        Direction current = game.direction;
+        bool reversal = (current == UP && dir == DOWN) || (current == DOWN && dir == UP) ||
+                        (current == LEFT && dir == RIGHT) || (current == RIGHT && dir == LEFT);
+        if (dir != NONE && !reversal) {
+            game.direction = dir;
+        }
+        
+        pair<int, int> newHead = game.snake.getHead();
+        switch (game.direction) {
+            case UP:    newHead.first--; break;
+            case DOWN:  newHead.first++; break;
+            case LEFT:  newHead.second--; break;
+            case RIGHT: newHead.second++; break;
+            case NONE:  break;
+        }
+        
+        Board& board = game.board;
+        if (CollisionDetector::isOutOfBounds(newHead, board) || CollisionDetector::isWall(newHead, board) ||
+            game.snake.checkSelfCollision(newHead, board)) {
+            game.gameOver = true;
+            return false;
+        }
+        
+        board.setJournal(&search.cellLog);
+        if (game.foodExists && newHead == game.food) {
+            game.snake.grow();
+            game.score += game.pointsPerFood;
+            board.setCellType(game.food.first, game.food.second, EMPTY);
+            game.foodExists = false;
+        }
+        
+        game.snake.move(newHead, board);
+        
+        if (!game.foodExists && !board.isFull()) {
+            search.moves.back().placedFood = true;
+            search.rngLog.push_back(game.rng);
+            size_t index = FoodManager::pickEmptyCell(board, game.rng);
+            if (index != SIZE_MAX) {
+                game.food = board.toPosition(index);
+                board.setCell(index, FOOD);
+                game.foodExists = true;
+            }
+        }
+        board.setJournal(nullptr);
+        
+        if (!game.foodExists && !game.snake.hasPendingGrowth()) {
+            game.gameOver = true;
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Reverts the most recent simulate() on a search state.
+     * @param search Search state with at least one simulated move
+     */
+    static void undo(SearchState& search) {
+        const SearchState::MoveUndo& move = search.moves.back();
+        GameCheckpoint& game = search.state;
+        
+        game.board.rollback(search.cellLog, move.cellMark);
+        game.snake.restore(move.snake);
+        if (move.placedFood) {
+            game.rng = search.rngLog.back();
+            search.rngLog.pop_back();
+        }
+        game.food = move.food;
+        game.foodExists = move.foodExists;
+        game.direction = move.direction;
+        game.score = move.score;
+        game.gameOver = move.gameOver;
+        search.moves.pop_back();
+    }
+
+    // ========================================================================
+    // BINARY SERIALIZATION
+    // ========================================================================
+    //
+    // Little-endian layout:
+    //   48-byte header  version, flags (game over, food present), direction,
+    //                   rows, cols, score, points per food, pending growth,
+    //                   food index, snake length, head index, RNG seed and
+    //                   RNG draw count
+    //   board           2 bits per cell (Board::writePacked)
+    //   body            2 bits per segment after the head: the Direction
+    //                   from each segment to the next
+    //
+    // A 20x40 game is about 260 bytes. Queued input and publishing settings
+    // are not part of the state.
+
+    /**
+     * @brief Gets the number of bytes serialize() needs for the current state.
+     * @return Serialized size in bytes
+     */
+    size_t getSerializedSize() const {
+        size_t steps = snake.getLength() > 0 ? snake.getLength() - 1 : 0;
+        return SERIAL_HEADER_SIZE + board.getPackedSize() + (steps + 3) / 4;
+    }
+
+    /**
+     * @brief Writes the game state into a caller-provided buffer (no allocation).
+     * @param out Destination buffer
+     * @return Bytes written, or 0 if out is smaller than getSerializedSize()
+     */
+    size_t serialize(span<uint8_t> out) const {
+        size_t total = getSerializedSize();
+        if (out.size() < total) return 0;
+        
+        size_t length = snake.getLength();
+        uint8_t* header = out.data();
+        header[0] = SERIAL_VERSION;
+        header[1] = static_cast<uint8_t>((gameOver ? 1 : 0) | (foodManager.isPresent() ? 2 : 0));
+        header[2] = static_cast<uint8_t>(directionController.getCurrent());
+        header[3] = 0;
+        putU32(header + 4, static_cast<uint32_t>(board.getRows()));
+        putU32(header + 8, static_cast<uint32_t>(board.getCols()));
+        putU32(header + 12, static_cast<uint32_t>(score));
+        putU32(header + 16, static_cast<uint32_t>(pointsPerFood));
+        putU32(header + 20, static_cast<uint32_t>(snake.getGrowthPending()));
+        pair<int, int> food = foodManager.getPosition();
+        putU32(header + 24, foodManager.isPresent() ? static_cast<uint32_t>(board.toIndex(food.first, food.second)) : 0);
+        putU32(header + 28, static_cast<uint32_t>(length));
+        putU32(header + 32, length > 0 ? snake.getSegmentIndex(0) : 0);
+        putU32(header + 36, rng.getSeed());
+        putU32(header + 40, static_cast<uint32_t>(rng.getDraws()));
+        putU32(header + 44, static_cast<uint32_t>(rng.getDraws() >> 32));
+        
+        board.writePacked(header + SERIAL_HEADER_SIZE);
+        
+        uint8_t* body = header + SERIAL_HEADER_SIZE + board.getPackedSize();
+        memset(body, 0, out.data() + total - body);
+        uint32_t cols = static_cast<uint32_t>(board.getCols());
+        for (size_t i = 1; i < length; i++) {
+            uint32_t from = snake.getSegmentIndex(i - 1);
+            uint32_t to = snake.getSegmentIndex(i);
+            uint8_t step = to + cols == from ? UP : to == from + cols ? DOWN : to + 1 == from ? LEFT : RIGHT;
+            body[(i - 1) / 4] |= static_cast<uint8_t>(step << (2 * ((i - 1) % 4)));
+        }
+        return total;
+    }
+
+    /**
+     * @brief Replaces the game state with one written by serialize().
+     * 
+     * Allocates nothing once the game has been initialized at the same board
+     * size. Food placement depends only on the board and the RNG, so a
+     * deserialized game continues exactly like the original.
+     * @param in Serialized state
+     * @return False (state unchanged) if the data is truncated or malformed
+     */
+    bool deserialize(span<const uint8_t> in) {
+        if (in.size() < SERIAL_HEADER_SIZE || in[0] != SERIAL_VERSION || in[2] > NONE) return false;
+        
+        const uint8_t* header = in.data();
+        uint32_t rows = getU32(header + 4);
+        uint32_t cols = getU32(header + 8);
+        uint32_t foodIndex = getU32(header + 24);
+        uint32_t length = getU32(header + 28);
+        uint32_t head = getU32(header + 32);
+        uint64_t cells = static_cast<uint64_t>(rows) * cols;
+        if (rows == 0 || cols == 0 || rows > INT32_MAX || cols > INT32_MAX || cells > UINT32_MAX) return false;
+        if (length == 0 || length > cells || head >= cells || foodIndex >= cells) return false;
+        
+        size_t packedSize = (cells + 3) / 4;
+        size_t steps = length - 1;
+        if (in.size() < SERIAL_HEADER_SIZE + packedSize + (steps + 3) / 4) return false;
+        
+        // Check the body stays on board SNAKE cells without crossing itself,
+        // covers every SNAKE cell, the food is the one FOOD cell (none when
+        // absent) and pending growth fits the empty cells, before touching
+        // any state
+        const uint8_t* packed = header + SERIAL_HEADER_SIZE;
+        const uint8_t* body = packed + packedSize;
+        auto packedCell = [packed](uint32_t index) { return (packed[index / 4] >> (2 * (index % 4))) & 3; };
+        bool foodExists = (header[1] & 2) != 0;
+        if (foodExists && packedCell(foodIndex) != FOOD) return false;
+        size_t counts[4];
+        Board::countPacked(packed, cells, counts);
+        if (counts[FOOD] != (foodExists ? 1u : 0u) || counts[SNAKE] != length) return false;
+        uint32_t growthPending = getU32(header + 20);
+        if (growthPending > INT32_MAX || growthPending > counts[EMPTY]) return false;
+        bodySeen.assign((cells + 63) / 64, 0);
+        uint32_t segment = head;
+        for (size_t i = 0; i <= steps; i++) {
+            if (i > 0) segment = stepIndex(segment, (body[(i - 1) / 4] >> (2 * ((i - 1) % 4))) & 3, rows, cols);
+            if (segment == UINT32_MAX || packedCell(segment) != SNAKE) return false;
+            uint64_t bit = uint64_t(1) << (segment & 63);
+            if (bodySeen[segment >> 6] & bit) return false;
+            bodySeen[segment >> 6] |= bit;
+        }
+        
+        board.readPacked(static_cast<int>(rows), static_cast<int>(cols), packed);
+        snake.beginRestore(board, static_cast<int>(growthPending));
+        segment = head;
+        snake.appendSegment(segment);
+        for (size_t i = 0; i < steps; i++) {
+            segment = stepIndex(segment, (body[i / 4] >> (2 * (i % 4))) & 3, rows, cols);
+            snake.appendSegment(segment);
+        }
+        
+        foodManager.restore(board.toPosition(foodIndex), foodExists);
+        directionController.initialize(static_cast<Direction>(header[2]));
+        rng.restore(getU32(header + 36), getU32(header + 40) | (static_cast<uint64_t>(getU32(header + 44)) << 32));
+        score = static_cast<int>(getU32(header + 12));
+        pointsPerFood = static_cast<int>(getU32(header + 16));
+        gameOver = (header[1] & 1) != 0;
+        publishState();
+        return true;
+    }
+
+    /**
+     * @brief Enables incremental publishing (board kept via deltas, no body copy).
+     * @param enabled True to publish deltas instead of full copies
+     */
+    void setIncrementalPublishing(bool enabled) {
+        statePublisher.setIncremental(enabled);
+    }
+
+    /**
+     * @brief Enables or disables publishing on every update (headless runs).
+     * @param enabled False to skip snapshots until publishNow() or re-enabling
+     */
+    void setPublishing(bool enabled) {
+        publishingEnabled = enabled;
+    }
+
+    /**
+     * @brief Publishes the current state immediately, even if publishing is disabled.
+     */
+    void publishNow() {
         statePublisher.publish(board, snake, foodManager, score, gameOver);
+        board.clearChanges();
+    }
+
+    /**
+     * @brief Resets the board change log without publishing, for readers
+     *        that follow getBoard() changes themselves with publishing disabled.
+     */
+    void clearBoardChanges() {
+        board.clearChanges();
+    }
+
+    /**
+     * @brief Checks whether state publishing is lock-free on this platform.
+     * @return True if the publisher's atomics are lock-free
+     */
+    static constexpr bool isStatePublishingLockFree() {
+        return StatePublisher::isLockFree();
     }
 
     /**
@@ -553,6 +1885,7 @@ public:
      * @return True if game continues, false if game over
      */
     bool update() {
+        PROFILE_SCOPE(PROBE_UPDATE);
         if (gameOver) {
             return false;
         }
@@ -566,19 +1899,19 @@ public:
         // Check collisions
         if (CollisionDetector::isOutOfBounds(newHead, board)) {
             gameOver = true;
-            statePublisher.publish(board, snake, foodManager, score, gameOver);
+            publishState();
             return false;
         }
         
         if (CollisionDetector::isWall(newHead, board)) {
             gameOver = true;
-            statePublisher.publish(board, snake, foodManager, score, gameOver);
+            publishState();
             return false;
         }
         
-        if (snake.checkSelfCollision(newHead)) {
+        if (snake.checkSelfCollision(newHead, board)) {
             gameOver = true;
-            statePublisher.publish(board, snake, foodManager, score, gameOver);
+            publishState();
             return false;
         }
         
@@ -600,20 +1933,31 @@ public:
         // Check win condition (board full)
         if (!foodManager.isPresent() && !snake.hasPendingGrowth()) {
             gameOver = true;
-            statePublisher.publish(board, snake, foodManager, score, gameOver);
+            publishState();
             return false;
         }
         
         // Publish updated state
-        statePublisher.publish(board, snake, foodManager, score, gameOver);
+        publishState();
         return true;
     }
 
+    // ========================================================================
+    // LOGIC-THREAD ACCESSORS (live state, not synchronized)
+    // ========================================================================
+
+    const Board& getBoard() const { return board; }
+    const Snake& getSnake() const { return snake; }
+    const FoodManager& getFoodManager() const { return foodManager; }
+    Direction getCurrentDirection() const { return directionController.getCurrent(); }
+    int getLiveScore() const { return score; }
+    bool isLiveGameOver() const { return gameOver; }
+
     // ========================================================================
     // THREAD-SAFE ACCESSORS (for render thread)
     // ========================================================================
 
-    shared_ptr<const GameState> getGameState() const {
+    StateHandle getGameState() const {
         return statePublisher.getState();
     }
 
@@ -637,10 +1981,10 @@ public:
         return state->gameOver;
     }
 
-    int getCellType(int r, int c) const {
+    CellType getCellType(int r, int c) const {
         auto state = statePublisher.getState();
         if (r >= 0 && r < state->rows && c >= 0 && c < state->cols) {
-            return state->board[r][c];
+            return state->cellAt(r, c);
         }
         return WALL;
     }
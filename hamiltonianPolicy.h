@@ -0,0 +1,213 @@
+// hamiltonianPolicy.h
+#ifndef HAMILTONIANPOLICY_H
+#define HAMILTONIANPOLICY_H
+
+#include "autopilot.h"
+
+// ============================================================================
+// HAMILTONIAN CYCLE POLICY
+// ============================================================================
+
+/**
+ * @brief Perfect-play policy that follows a precomputed Hamiltonian cycle.
+ *
+ * The cycle is built once per board size and stored as two flat tables:
+ * each cell's position along the cycle and the Direction to its successor.
+ * Following the cycle can never collide once the body lies in cycle order
+ * from tail to head, so the snake always fills the board.
+ *
+ * To finish sooner the head may take a shortcut to any neighbour further
+ * along the cycle that is closer (in cycle distance) to the food, provided
+ * it stays strictly ahead of the head and behind the tail, with room left
+ * for pending growth. Shortcuts keep the body in cycle order, so the
+ * guarantee holds. A decision is four table lookups and a few comparisons.
+ *
+ * A cycle needs an even side and no walls; on odd-by-odd boards, 1-wide
+ * ones and levels with walls the policy falls back to the Autopilot. The
+ * cycle is laid out so the snake's starting row runs RIGHT on boards with
+ * an even number of rows; otherwise the policy follows the cycle without
+ * shortcuts until the body has lined up.
+ */
+class HamiltonianPolicy {
+private:
+    vector<uint32_t> cycleIndex;     ///< Position of each cell along the cycle
+    vector<uint8_t> nextDirection;   ///< Direction from each cell to its successor
+    vector<uint32_t> cycleCell;      ///< Cell at each cycle position
+    int rows = 0;
+    int cols = 0;
+    bool hasCycle = false;
+    uint32_t expectedHead = UINT32_MAX;
+    size_t alignedMoves = 0;         ///< Consecutive moves that kept the body in cycle order
+    Autopilot fallback;
+
+    /**
+     * @brief Builds the cycle tables for a board size.
+     *
+     * Rows (or columns, if only those are even) are walked as a serpentine
+     * over all but one edge column, which carries the way back. Boards
+     * with walls get no cycle.
+     * @param board Board to lay the cycle on
+     */
+    void build(const Board& board) {
+        rows = board.getRows();
+        cols = board.getCols();
+        size_t cells = board.getCellCount();
+        hasCycle = rows >= 2 && cols >= 2 && (rows % 2 == 0 || cols % 2 == 0) &&
+                   find(board.data(), board.data() + cells, WALL) == board.data() + cells;
+        expectedHead = UINT32_MAX;
+        alignedMoves = 0;
+        if (!hasCycle) return;
+
+        // Lay the serpentine along the even side; if that is the column
+        // count, walk the transposed board
+        bool transpose = rows % 2 != 0;
+        int laneCount = transpose ? cols : rows;
+        int laneLength = transpose ? rows : cols;
+        // Mirror so the starting row (rows / 2) runs RIGHT
+        bool mirror = !transpose && (rows / 2) % 2 != 0;
+        auto cellAt = [&](int lane, int along) {
+            if (mirror) along = laneLength - 1 - along;
+            return static_cast<uint32_t>(transpose ? static_cast<size_t>(along) * cols + lane
+                                                   : static_cast<size_t>(lane) * cols + along);
+        };
+
+        cycleCell.clear();
+        cycleCell.reserve(cells);
+        for (int lane = 0; lane < laneCount; lane++) {
+            if (lane % 2 == 0) {
+                for (int along = 1; along < laneLength; along++) cycleCell.push_back(cellAt(lane, along));
+            } else {
+                for (int along = laneLength - 1; along >= 1; along--) cycleCell.push_back(cellAt(lane, along));
+            }
+        }
+        for (int lane = laneCount - 1; lane >= 0; lane--) {
+            cycleCell.push_back(cellAt(lane, 0));
+        }
+
+        cycleIndex.resize(cells);
+        nextDirection.resize(cells);
+        for (size_t i = 0; i < cells; i++) {
+            uint32_t from = cycleCell[i];
+            uint32_t to = cycleCell[(i + 1) % cells];
+            cycleIndex[from] = static_cast<uint32_t>(i);
+            nextDirection[from] = static_cast<uint8_t>(
+                to + cols == from ? UP : to == from + cols ? DOWN : to + 1 == from ? LEFT : RIGHT);
+        }
+    }
+
+    /**
+     * @brief Cycle distance from one cell forward to another.
+     * @param from Start cell
+     * @param to End cell
+     * @return Number of cycle steps, 0 if equal
+     */
+    uint32_t cycleDistance(uint32_t from, uint32_t to) const {
+        uint32_t cells = static_cast<uint32_t>(cycleCell.size());
+        uint32_t a = cycleIndex[from];
+        uint32_t b = cycleIndex[to];
+        return b >= a ? b - a : b + cells - a;
+    }
+
+    static uint32_t neighbour(uint32_t cell, int dir, int rows, int cols) {
+        uint32_t r = cell / cols;
+        uint32_t c = cell % cols;
+        switch (dir) {
+            case UP:    return r > 0 ? cell - cols : UINT32_MAX;
+            case DOWN:  return r + 1 < static_cast<uint32_t>(rows) ? cell + cols : UINT32_MAX;
+            case LEFT:  return c > 0 ? cell - 1 : UINT32_MAX;
+            default:    return c + 1 < static_cast<uint32_t>(cols) ? cell + 1 : UINT32_MAX;
+        }
+    }
+
+public:
+    void reset(unsigned int seed) {
+        rows = cols = 0;   // the next game may be on another level
+        expectedHead = UINT32_MAX;
+        alignedMoves = 0;
+        fallback.reset(seed);
+    }
+
+    /**
+     * @brief Chooses the next move for the live game (logic thread).
+     * @param game Game being played
+     * @return Direction to queue, or NONE when every move is fatal
+     */
+    Direction operator()(const SnakeGameLogic& game) {
+        const Board& board = game.getBoard();
+        const Snake& snake = game.getSnake();
+        if (board.getRows() != rows || board.getCols() != cols || cycleIndex.size() != board.getCellCount()) {
+            build(board);
+        }
+        if (!hasCycle) return fallback(game);
+
+        uint32_t head = snake.getSegmentIndex(0);
+        if (head != expectedHead) {
+            alignedMoves = 0;
+        }
+        Direction follow = static_cast<Direction>(nextDirection[head]);
+        uint32_t followCell = neighbour(head, follow, rows, cols);
+
+        // Until the whole body was laid by cycle moves, just follow the cycle
+        if (alignedMoves < snake.getLength()) {
+            if (Autopilot::canEnter(board, snake, followCell)) {
+                alignedMoves++;
+                expectedHead = followCell;
+                return follow;
+            }
+            alignedMoves = 0;
+            Direction escape = fallback(game);
+            expectedHead = escape != NONE ? neighbour(head, escape, rows, cols) : UINT32_MAX;
+            return escape;
+        }
+
+        Direction best = follow;
+        uint32_t bestCell = followCell;
+        if (game.getFoodManager().isPresent()) {
+            pair<int, int> position = game.getFoodManager().getPosition();
+            uint32_t food = static_cast<uint32_t>(board.toIndex(position.first, position.second));
+            uint32_t tail = snake.getSegmentIndex(snake.getLength() - 1);
+            uint32_t toTail = snake.getLength() > 1 ? cycleDistance(head, tail) : static_cast<uint32_t>(cycleCell.size());
+            uint32_t bestToFood = cycleDistance(followCell, food);
+            uint32_t growth = static_cast<uint32_t>(snake.getGrowthPending());
+
+            for (int dir = UP; dir <= RIGHT; dir++) {
+                uint32_t cell = neighbour(head, dir, rows, cols);
+                if (cell == UINT32_MAX || cell == followCell || (board.getCell(cell) != EMPTY && cell != food)) continue;
+
+                // Strictly between head and tail, with room to grow afterwards
+                uint32_t jump = cycleDistance(head, cell);
+                if (jump == 0 || jump >= toTail) continue;
+                if (cycleDistance(cell, tail) <= growth + 1 + (cell == food)) continue;
+
+                uint32_t toFood = cycleDistance(cell, food);
+                if (toFood < bestToFood) {
+                    best = static_cast<Direction>(dir);
+                    bestCell = cell;
+                    bestToFood = toFood;
+                }
+            }
+        }
+
+        alignedMoves++;
+        expectedHead = bestCell;
+        return best;
+    }
+
+    /**
+     * @brief Queues the policy's move on the game (logic thread).
+     *
+     * Must be the only producer on DirectionController's single-producer
+     * input ring while it drives a game: any other queued turn takes the
+     * snake off the cycle (expectedHead no longer matches), so it loses the
+     * fill guarantee until the body lines up again.
+     * @param game Game to steer
+     */
+    void steer(SnakeGameLogic& game) {
+        Direction dir = (*this)(game);
+        if (dir != NONE) {
+            game.setDirection(dir);
+        }
+    }
+};
+
+#endif // HAMILTONIANPOLICY_H
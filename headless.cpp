@@ -0,0 +1,366 @@
+#include "parallelRunner.h"
+#include "hamiltonianPolicy.h"
+#include "level.h"
+#include "batchedEngine.h"
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+
+using namespace std;
+
+// ============================================
+// Built-in Policies
+// ============================================
+
+// Picks a random non-reversing direction every few ticks
+class RandomPolicy {
+private:
+    mt19937 rng;
+    
+public:
+    explicit RandomPolicy(unsigned int seed = 0) : rng(seed) {}
+    
+    void reset(unsigned int seed) {
+        rng.seed(seed);
+    }
+    
+    Direction operator()(const SnakeGameLogic&) {
+        uniform_int_distribution<int> dist(0, 7);
+        int roll = dist(rng);
+        return roll < 4 ? static_cast<Direction>(roll) : NONE;
+    }
+};
+
+// Steps toward the food, avoiding moves that end the game this tick
+class GreedyPolicy {
+public:
+    Direction operator()(const SnakeGameLogic& game) {
+        const Board& board = game.getBoard();
+        const Snake& snake = game.getSnake();
+        pair<int, int> head = snake.getHead();
+        pair<int, int> food = game.getFoodManager().getPosition();
+        Direction current = game.getCurrentDirection();
+        
+        static const Direction candidates[] = {UP, DOWN, LEFT, RIGHT};
+        static const Direction opposite[] = {DOWN, UP, RIGHT, LEFT};
+        static const int rowStep[] = {-1, 1, 0, 0};
+        static const int colStep[] = {0, 0, -1, 1};
+        
+        Direction best = NONE;
+        int bestDistance = INT32_MAX;
+        for (int i = 0; i < 4; i++) {
+            if (current != NONE && opposite[current] == candidates[i]) continue;
+            pair<int, int> next = {head.first + rowStep[i], head.second + colStep[i]};
+            if (!board.isInBounds(next.first, next.second)) continue;
+            if (board.getCellType(next.first, next.second) == WALL) continue;
+            if (snake.checkSelfCollision(next, board)) continue;
+            
+            int distance = abs(next.first - food.first) + abs(next.second - food.second);
+            if (distance < bestDistance || (distance == bestDistance && candidates[i] == current)) {
+                best = candidates[i];
+                bestDistance = distance;
+            }
+        }
+        return best;
+    }
+};
+
+// Calls visit with a fresh instance of the named policy
+template <typename Visit>
+static auto withPolicy(const string& name, Visit&& visit) {
+    if (name == "random") return visit(RandomPolicy());
+    if (name == "autopilot") return visit(Autopilot());
+    if (name == "hamiltonian") return visit(HamiltonianPolicy());
+    return visit(GreedyPolicy());
+}
+
+// ============================================
+// Main
+// ============================================
+
+static void printUsage(const char* program) {
+    cout << "Usage: " << program << " [options]\n"
+         << "  --games N       Number of games to play (default 1000)\n"
+         << "  --seed S        Seed of the first game (default 1)\n"
+         << "  --rows R        Board rows (default 20)\n"
+         << "  --cols C        Board columns (default 40)\n"
+         << "  --level FILE    Play on a level pack (ASCII or binary); sets rows and cols\n"
+         << "  --level-index N Level of the pack to play (default 0)\n"
+         << "  --write-level OUT  With --level, save the pack in binary form to OUT\n"
+         << "  --length L      Starting snake length (default 3)\n"
+         << "  --max-ticks T   Tick limit per game (default 100 * rows * cols)\n"
+         << "  --policy P      random | greedy | autopilot | hamiltonian\n"
+         << "                  (default greedy)\n"
+         << "  --threads N     Worker threads; 0 = all cores (default 1)\n"
+         << "  --verbose       Print one line per game\n"
+         << "  --record FILE   Play only the first game and save its replay to FILE\n"
+         << "  --replay FILE   Play back a recorded game at full speed and verify it\n"
+         << "  --seek T        With --replay, also report the position at tick T\n"
+         << "  --check-batched Play --games games on BatchedSnakeEngine and SnakeGameLogic\n"
+         << "                  side by side and verify they never diverge\n";
+}
+
+// Plays a replay to the end and checks it reaches the recorded score
+static int playReplay(const string& path, uint64_t seekTick, bool seek) {
+    Replay replay;
+    if (!replay.load(path)) {
+        cerr << "Cannot read replay " << path << "\n";
+        return 1;
+    }
+    
+    ReplayPlayer player(replay);
+    auto start = chrono::steady_clock::now();
+    player.playToEnd();
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    
+    const SnakeGameLogic& game = player.getGame();
+    bool matches = game.getLiveScore() == replay.finalScore;
+    cout << fixed << setprecision(3)
+         << "seed:          " << replay.seed << "\n"
+         << "ticks:         " << player.getTick() << " / " << player.getTickCount() << "\n"
+         << "elapsed:       " << elapsed * 1000.0 << " ms\n"
+         << "score:         " << game.getLiveScore() << " (recorded " << replay.finalScore << ")\n"
+         << "result:        " << (matches ? "match" : "MISMATCH") << "\n";
+    
+    if (seek) {
+        player.seek(seekTick);
+        pair<int, int> head = game.getSnake().getHead();
+        cout << "tick " << player.getTick() << ":  score " << game.getLiveScore()
+             << "  length " << game.getSnake().getLength()
+             << "  head (" << head.first << ", " << head.second << ")\n";
+    }
+    return matches ? 0 : 1;
+}
+
+// Steps every game in a BatchedSnakeEngine and in its own SnakeGameLogic
+// with the same inputs (greedy moves, with one in eight replaced by a
+// random direction so reversals and NONE are covered) and compares the
+// full state after every tick
+static int checkBatched(const SimulationConfig& config, unsigned int seed, uint64_t games) {
+    size_t count = static_cast<size_t>(games);
+    uint64_t maxTicks = config.maxTicks > 0 ? config.maxTicks : 100ull * config.rows * config.cols;
+    BatchedSnakeEngine engine(count, config.rows, config.cols, config.startingLength,
+                              config.pointsPerFood, config.initialDirection);
+    unique_ptr<SnakeGameLogic[]> reference = make_unique<SnakeGameLogic[]>(count);
+    for (size_t g = 0; g < count; g++) {
+        unsigned int gameSeed = seed + static_cast<unsigned int>(g);
+        engine.reset(g, gameSeed);
+        reference[g].setPublishing(false);
+        reference[g].setSeed(gameSeed);
+        reference[g].initializeBoard(config.rows, config.cols, config.startingLength,
+                                     config.pointsPerFood, config.initialDirection);
+    }
+    
+    GreedyPolicy greedy;
+    mt19937 rng(seed);
+    vector<Direction> actions(count, NONE);
+    size_t cellCount = static_cast<size_t>(config.rows) * config.cols;
+    uint64_t gameSteps = 0;
+    uint64_t tick = 0;
+    auto start = chrono::steady_clock::now();
+    for (size_t running = count; running > 0 && tick < maxTicks; tick++) {
+        for (size_t g = 0; g < count; g++) {
+            if (engine.isDone(g)) continue;
+            actions[g] = rng() % 8 == 0 ? static_cast<Direction>(rng() % 5) : greedy(reference[g]);
+            reference[g].setDirection(actions[g]);
+            reference[g].update();
+            gameSteps++;
+        }
+        running = engine.step(actions.data());
+        
+        for (size_t g = 0; g < count; g++) {
+            const SnakeGameLogic& game = reference[g];
+            span<const CellType> board = engine.getBoard(g);
+            bool same = engine.isDone(g) == game.isLiveGameOver() &&
+                        engine.getScore(g) == game.getLiveScore() &&
+                        engine.getLength(g) == game.getSnake().getLength() &&
+                        engine.getHead(g) == game.getSnake().getHead() &&
+                        engine.hasFood(g) == game.getFoodManager().isPresent() &&
+                        (!engine.hasFood(g) || engine.getFood(g) == game.getFoodManager().getPosition());
+            for (size_t cell = 0; same && cell < cellCount; cell++) {
+                same = board[cell] == game.getBoard().getCell(cell);
+            }
+            if (!same) {
+                cout << "MISMATCH: game " << g << " (seed " << seed + g << ") at tick " << tick + 1 << "\n";
+                return 1;
+            }
+        }
+    }
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << fixed << setprecision(3)
+         << "games:         " << count << "\n"
+         << "lockstep ticks: " << tick << " (" << gameSteps << " game steps)\n"
+         << "elapsed:       " << elapsed << " s\n"
+         << "result:        match\n";
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    SimulationConfig config;
+    uint64_t games = 1000;
+    unsigned int seed = 1;
+    string policyName = "greedy";
+    bool verbose = false;
+    unsigned int threads = 1;
+    string recordPath;
+    string replayPath;
+    uint64_t seekTick = 0;
+    bool seek = false;
+    string levelPath;
+    size_t levelIndex = 0;
+    string writeLevelPath;
+    bool checkBatchedEngine = false;
+    
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--games") == 0 && hasValue) {
+            games = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--seed") == 0 && hasValue) {
+            seed = static_cast<unsigned int>(strtoul(argv[++i], nullptr, 10));
+        } else if (strcmp(argv[i], "--rows") == 0 && hasValue) {
+            config.rows = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--cols") == 0 && hasValue) {
+            config.cols = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--level") == 0 && hasValue) {
+            levelPath = argv[++i];
+        } else if (strcmp(argv[i], "--level-index") == 0 && hasValue) {
+            levelIndex = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--write-level") == 0 && hasValue) {
+            writeLevelPath = argv[++i];
+        } else if (strcmp(argv[i], "--length") == 0 && hasValue) {
+            config.startingLength = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--max-ticks") == 0 && hasValue) {
+            config.maxTicks = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--policy") == 0 && hasValue) {
+            policyName = argv[++i];
+        } else if (strcmp(argv[i], "--threads") == 0 && hasValue) {
+            threads = static_cast<unsigned int>(strtoul(argv[++i], nullptr, 10));
+        } else if (strcmp(argv[i], "--verbose") == 0) {
+            verbose = true;
+        } else if (strcmp(argv[i], "--record") == 0 && hasValue) {
+            recordPath = argv[++i];
+        } else if (strcmp(argv[i], "--replay") == 0 && hasValue) {
+            replayPath = argv[++i];
+        } else if (strcmp(argv[i], "--check-batched") == 0) {
+            checkBatchedEngine = true;
+        } else if (strcmp(argv[i], "--seek") == 0 && hasValue) {
+            seekTick = strtoull(argv[++i], nullptr, 10);
+            seek = true;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    
+    // The pack stays mapped for the whole run; every game (on every
+    // thread) initializes its board straight from the mapped cells
+    LevelPack levels;
+    if (!levelPath.empty()) {
+        string error;
+        if (!levels.open(levelPath, error)) {
+            cerr << error << "\n";
+            return 1;
+        }
+        if (levelIndex >= levels.getLevelCount()) {
+            cerr << levelPath << " has " << levels.getLevelCount() << " level(s)\n";
+            return 1;
+        }
+        if (!writeLevelPath.empty()) {
+            if (!levels.writeBinary(writeLevelPath)) {
+                cerr << "Cannot write level pack " << writeLevelPath << "\n";
+                return 1;
+            }
+            cout << "wrote " << levels.getLevelCount() << " level(s) to " << writeLevelPath << "\n";
+            return 0;
+        }
+        LevelView level = levels.getLevel(levelIndex);
+        config.rows = level.rows;
+        config.cols = level.cols;
+        config.layout = level.cells;
+    }
+    
+    if (config.rows < 1 || config.cols < 1 || config.startingLength < 1 ||
+        (policyName != "random" && policyName != "greedy" && policyName != "autopilot" &&
+         policyName != "hamiltonian")) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    
+    if (checkBatchedEngine) {
+        // BatchedSnakeEngine has no wall support
+        if (config.layout) {
+            cerr << "--check-batched does not support --level\n";
+            return 1;
+        }
+        return checkBatched(config, seed, games);
+    }
+    
+    if (!replayPath.empty()) {
+        return playReplay(replayPath, seekTick, seek);
+    }
+    
+    if (!recordPath.empty()) {
+        HeadlessRunner runner(config);
+        ReplayRecorder recorder;
+        SimulationResult result = withPolicy(policyName, [&](auto policy) {
+            return runner.runGame(seed, policy, &recorder);
+        });
+        if (!recorder.getReplay().save(recordPath)) {
+            cerr << "Cannot write replay " << recordPath << "\n";
+            return 1;
+        }
+        cout << "recorded seed " << result.seed << "  score " << result.score
+             << "  ticks " << result.ticks << "  ("
+             << recorder.getReplay().inputs.getRuns().size() << " bytes of input)\n";
+        return 0;
+    }
+    
+    if (threads != 1) {
+        ParallelRunner parallel(config, threads);
+        ParallelStats result = withPolicy(policyName, [&](auto policy) {
+            return parallel.run(seed, static_cast<uint32_t>(games), [&policy](unsigned int) { return policy; });
+        });
+        
+        const BatchStats& stats = result.totals;
+        cout << fixed << setprecision(2)
+             << "threads:       " << result.threads << " (" << result.steals << " steals)\n"
+             << "games:         " << stats.games << "\n"
+             << "ticks:         " << stats.totalTicks << "\n"
+             << "elapsed:       " << stats.elapsedSeconds << " s\n"
+             << "ticks/sec:     " << setprecision(0) << stats.ticksPerSecond() << "\n"
+             << setprecision(2)
+             << "average score: " << stats.averageScore() << "\n"
+             << "score p50/p90/p99: " << result.distribution.scorePercentile(50) << " / "
+             << result.distribution.scorePercentile(90) << " / "
+             << result.distribution.scorePercentile(99) << "\n"
+             << "best score:    " << stats.bestScore << "\n"
+             << "boards filled: " << stats.boardsFilled << "\n";
+        return 0;
+    }
+    
+    HeadlessRunner runner(config);
+    auto report = [verbose](const SimulationResult& result) {
+        if (verbose) {
+            cout << "seed " << result.seed << "  score " << result.score 
+                 << "  length " << result.length << "  ticks " << result.ticks
+                 << (result.boardFilled ? "  (board filled)" : "")
+                 << (result.hitTickLimit ? "  (tick limit)" : "") << "\n";
+        }
+    };
+    
+    BatchStats stats = withPolicy(policyName, [&](auto policy) {
+        return runner.runBatch(seed, games, policy, report);
+    });
+    
+    cout << fixed << setprecision(2)
+         << "games:         " << stats.games << "\n"
+         << "ticks:         " << stats.totalTicks << "\n"
+         << "elapsed:       " << stats.elapsedSeconds << " s\n"
+         << "ticks/sec:     " << setprecision(0) << stats.ticksPerSecond() << "\n"
+         << setprecision(2)
+         << "average score: " << stats.averageScore() << "\n"
+         << "best score:    " << stats.bestScore << "\n"
+         << "boards filled: " << stats.boardsFilled << "\n";
+    return 0;
+}
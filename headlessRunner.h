@@ -0,0 +1,166 @@
+// headlessRunner.h
+#ifndef HEADLESSRUNNER_H
+#define HEADLESSRUNNER_H
+
+#include "gameLogic.h"
+#include "replay.h"
+
+// ============================================================================
+// HEADLESS SIMULATION
+// ============================================================================
+
+/**
+ * @brief Game parameters for headless runs (mirrors runGame's settings).
+ */
+struct SimulationConfig {
+    int rows = 20;
+    int cols = 40;
+    int startingLength = 3;
+    int pointsPerFood = 10;
+    Direction initialDirection = RIGHT;
+    uint64_t maxTicks = 0;           ///< Tick limit per game; 0 means 100 * rows * cols
+    const CellType* layout = nullptr; ///< Optional walls (rows * cols cells), e.g. a mapped level
+};
+
+/**
+ * @brief Outcome of a single headless game.
+ */
+struct SimulationResult {
+    unsigned int seed;               ///< Seed the game was played with
+    int score;                       ///< Final score
+    size_t length;                   ///< Final snake length
+    uint64_t ticks;                  ///< Number of update() calls
+    bool boardFilled;                ///< Game ended because the board was full
+    bool hitTickLimit;               ///< Game was cut off by maxTicks
+};
+
+/**
+ * @brief Aggregate statistics over a batch of headless games.
+ */
+struct BatchStats {
+    uint64_t games = 0;
+    uint64_t totalTicks = 0;
+    long long totalScore = 0;
+    int bestScore = 0;
+    uint64_t boardsFilled = 0;
+    double elapsedSeconds = 0.0;
+
+    void add(const SimulationResult& result) {
+        games++;
+        totalTicks += result.ticks;
+        totalScore += result.score;
+        bestScore = max(bestScore, result.score);
+        if (result.boardFilled) boardsFilled++;
+    }
+
+    void merge(const BatchStats& other) {
+        games += other.games;
+        totalTicks += other.totalTicks;
+        totalScore += other.totalScore;
+        bestScore = max(bestScore, other.bestScore);
+        boardsFilled += other.boardsFilled;
+    }
+
+    double ticksPerSecond() const {
+        return elapsedSeconds > 0.0 ? totalTicks / elapsedSeconds : 0.0;
+    }
+
+    double averageScore() const {
+        return games > 0 ? static_cast<double>(totalScore) / games : 0.0;
+    }
+};
+
+/**
+ * @brief Drives SnakeGameLogic without a terminal, as fast as possible.
+ * 
+ * A policy is any callable `Direction(const SnakeGameLogic&)` invoked once
+ * per tick before update(); returning NONE keeps the current direction.
+ * If the policy has a `reset(unsigned int seed)` member it is called at the
+ * start of every game, so stateful policies replay identically per seed.
+ * Policies read live state through the logic-thread accessors, so
+ * publishing is disabled for the whole run. The same SnakeGameLogic is
+ * re-initialized for every game, reusing its board and snake storage.
+ */
+class HeadlessRunner {
+private:
+    SimulationConfig config;
+    SnakeGameLogic game;
+
+public:
+    explicit HeadlessRunner(const SimulationConfig& config) : config(config) {
+        game.setPublishing(false);
+    }
+
+    /**
+     * @brief Plays one game to completion (or the tick limit).
+     * @param seed RNG seed for food placement
+     * @param policy Callable producing a Direction per tick
+     * @param recorder Optional recorder capturing the game for replay
+     * @return Result of the game
+     */
+    template <typename Policy>
+    SimulationResult runGame(unsigned int seed, Policy&& policy, ReplayRecorder* recorder = nullptr) {
+        game.setSeed(seed);
+        if constexpr (requires { policy.reset(seed); }) {
+            policy.reset(seed);
+        }
+        game.initializeBoard(config.rows, config.cols, config.startingLength,
+                             config.pointsPerFood, config.initialDirection, config.layout);
+        if (recorder) {
+            recorder->begin(seed, config.rows, config.cols, config.startingLength,
+                            config.pointsPerFood, config.initialDirection, config.layout);
+        }
+        
+        uint64_t maxTicks = config.maxTicks > 0 
+            ? config.maxTicks 
+            : 100 * static_cast<uint64_t>(config.rows) * config.cols;
+        
+        SimulationResult result{seed, 0, 0, 0, false, false};
+        bool running = true;
+        while (running && result.ticks < maxTicks) {
+            Direction dir = policy(static_cast<const SnakeGameLogic&>(game));
+            if (dir != NONE) {
+                game.setDirection(dir);
+            }
+            running = game.update();
+            result.ticks++;
+            if (recorder) recorder->recordTick(game);
+        }
+        if (recorder) recorder->finish(game);
+        
+        result.score = game.getLiveScore();
+        result.length = game.getSnake().getLength();
+        result.boardFilled = game.getBoard().isFull() && !game.getFoodManager().isPresent();
+        result.hitTickLimit = running;
+        return result;
+    }
+
+    /**
+     * @brief Plays consecutive seeds and aggregates the results.
+     * @param firstSeed Seed of the first game; game i uses firstSeed + i
+     * @param gameCount Number of games to play
+     * @param policy Callable producing a Direction per tick
+     * @param onResult Callable receiving each SimulationResult
+     * @return Aggregate statistics including wall-clock throughput
+     */
+    template <typename Policy, typename OnResult>
+    BatchStats runBatch(unsigned int firstSeed, uint64_t gameCount, Policy&& policy, OnResult&& onResult) {
+        BatchStats stats;
+        auto start = chrono::steady_clock::now();
+        for (uint64_t i = 0; i < gameCount; i++) {
+            SimulationResult result = runGame(firstSeed + static_cast<unsigned int>(i), policy);
+            stats.add(result);
+            onResult(result);
+        }
+        stats.elapsedSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        return stats;
+    }
+
+    /**
+     * @brief Gives access to the game for deferred publishing or inspection.
+     * @return Reference to the underlying game logic
+     */
+    SnakeGameLogic& getGame() { return game; }
+};
+
+#endif // HEADLESSRUNNER_H
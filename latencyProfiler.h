@@ -0,0 +1,230 @@
+// latencyProfiler.h
+#ifndef LATENCYPROFILER_H
+#define LATENCYPROFILER_H
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <ostream>
+
+using namespace std;
+
+// ============================================================================
+// LATENCY PROFILING
+// ============================================================================
+//
+// Build with -DSNAKE_PROFILE to record hot-path timings. Without it,
+// PROFILE_SCOPE expands to nothing and no timing code is compiled in.
+
+/**
+ * @brief Instrumented code paths.
+ */
+enum ProbeId {
+    PROBE_UPDATE = 0,    ///< SnakeGameLogic::update
+    PROBE_PUBLISH,       ///< StatePublisher::publish
+    PROBE_RENDER,        ///< GameRenderer::updateGameBoard (frames drawn)
+    PROBE_INPUT,         ///< Decoding a key and queueing its direction
+    PROBE_COUNT
+};
+
+inline const char* probeName(int probe) {
+    static const char* names[PROBE_COUNT] = {"update", "publish", "render", "input"};
+    return probe >= 0 && probe < PROBE_COUNT ? names[probe] : "?";
+}
+
+/**
+ * @brief Log-linear latency histogram in nanoseconds.
+ * 
+ * Values below 16 ns get exact buckets; above that each power of two is
+ * split into four buckets (at most 25% error). Written by one thread with
+ * relaxed atomics so another thread can read it at any time without locks.
+ */
+class LatencyHistogram {
+public:
+    static constexpr int BUCKETS = 256;
+
+private:
+    array<atomic<uint64_t>, BUCKETS> counts{};
+    atomic<uint64_t> total{0};
+    atomic<uint64_t> maxNs{0};
+
+    static int bucketOf(uint64_t ns) {
+        if (ns < 16) return static_cast<int>(ns);
+        int exponent = bit_width(ns) - 1;
+        int sub = static_cast<int>((ns >> (exponent - 2)) & 3);
+        return 16 + (exponent - 4) * 4 + sub;
+    }
+
+    static uint64_t bucketUpperBound(int bucket) {
+        if (bucket < 16) return static_cast<uint64_t>(bucket);
+        int exponent = (bucket - 16) / 4 + 4;
+        uint64_t sub = static_cast<uint64_t>((bucket - 16) % 4);
+        uint64_t base = uint64_t(1) << exponent;
+        return base + (sub + 1) * (base >> 2) - 1;
+    }
+
+public:
+    // Owner thread only; plain load/store keeps recording a few nanoseconds
+    void record(uint64_t ns) {
+        atomic<uint64_t>& bucket = counts[bucketOf(ns)];
+        bucket.store(bucket.load(memory_order_relaxed) + 1, memory_order_relaxed);
+        total.store(total.load(memory_order_relaxed) + 1, memory_order_relaxed);
+        if (ns > maxNs.load(memory_order_relaxed)) maxNs.store(ns, memory_order_relaxed);
+    }
+
+    uint64_t getCount() const { return total.load(memory_order_relaxed); }
+    uint64_t getMax() const { return maxNs.load(memory_order_relaxed); }
+
+    /**
+     * @brief Gets an upper bound for a percentile.
+     * @param percentile Value in [0, 100]
+     * @return Upper edge of the bucket holding that percentile, in ns
+     */
+    uint64_t percentile(double percentile) const {
+        uint64_t count = getCount();
+        if (count == 0) return 0;
+        uint64_t threshold = static_cast<uint64_t>(percentile / 100.0 * count);
+        if (threshold == 0) threshold = 1;
+        uint64_t seen = 0;
+        for (int i = 0; i < BUCKETS; i++) {
+            seen += counts[i].load(memory_order_relaxed);
+            if (seen >= threshold) return min(bucketUpperBound(i), getMax());
+        }
+        return getMax();
+    }
+};
+
+/**
+ * @brief Histograms for all probes recorded by one thread.
+ */
+struct ThreadProfile {
+    static constexpr size_t NAME_LENGTH = 16;
+
+    atomic<bool> inUse{false};
+    atomic<bool> everUsed{false};
+    char name[NAME_LENGTH] = {};
+    array<LatencyHistogram, PROBE_COUNT> probes;
+};
+
+/**
+ * @brief Process-wide registry of per-thread profiles.
+ * 
+ * A thread claims a slot on its first recording. When it exits the slot is
+ * released but keeps its data, and the next thread with the same name
+ * (e.g. the input thread of the next game) continues in it. Slots are
+ * claimed with CAS, so registration never locks.
+ */
+class LatencyProfiler {
+public:
+    static constexpr size_t MAX_THREADS = 16;
+
+private:
+    inline static array<ThreadProfile, MAX_THREADS> slots;
+    inline static ThreadProfile overflowSlot;   ///< Shared fallback if all slots are taken
+    inline static thread_local const char* threadName = "main";
+
+    static bool tryClaim(ThreadProfile& slot) {
+        bool expected = false;
+        return slot.inUse.compare_exchange_strong(expected, true, memory_order_acq_rel);
+    }
+
+    struct SlotGuard {
+        ThreadProfile* slot = nullptr;
+
+        SlotGuard() {
+            // Prefer resuming a released slot with this thread's name
+            for (ThreadProfile& candidate : slots) {
+                if (candidate.everUsed.load(memory_order_acquire) && 
+                    strncmp(candidate.name, threadName, ThreadProfile::NAME_LENGTH - 1) == 0 &&
+                    tryClaim(candidate)) {
+                    slot = &candidate;
+                    return;
+                }
+            }
+            for (ThreadProfile& candidate : slots) {
+                if (!candidate.everUsed.load(memory_order_acquire) && tryClaim(candidate)) {
+                    strncpy(candidate.name, threadName, ThreadProfile::NAME_LENGTH - 1);
+                    candidate.everUsed.store(true, memory_order_release);
+                    slot = &candidate;
+                    return;
+                }
+            }
+            slot = &overflowSlot;
+        }
+
+        ~SlotGuard() {
+            if (slot != &overflowSlot) slot->inUse.store(false, memory_order_release);
+        }
+    };
+
+public:
+    /**
+     * @brief Names the calling thread in reports; call before its first probe.
+     * @param name Static string, at most 15 characters are kept
+     */
+    static void nameThread(const char* name) {
+        threadName = name;
+    }
+
+    static ThreadProfile& local() {
+        thread_local SlotGuard guard;
+        return *guard.slot;
+    }
+
+    /**
+     * @brief Writes a p50/p99/max table for every thread and probe seen.
+     * @param out Stream to write to
+     */
+    static void dump(ostream& out) {
+        out << left << setw(10) << "thread" << setw(10) << "probe" 
+            << right << setw(12) << "count" << setw(12) << "p50 (us)" 
+            << setw(12) << "p99 (us)" << setw(12) << "max (us)" << "\n";
+        out << fixed << setprecision(2);
+        for (const ThreadProfile& slot : slots) {
+            if (!slot.everUsed.load(memory_order_acquire)) continue;
+            for (int probe = 0; probe < PROBE_COUNT; probe++) {
+                const LatencyHistogram& histogram = slot.probes[probe];
+                if (histogram.getCount() == 0) continue;
+                out << left << setw(10) << slot.name << setw(10) << probeName(probe) << right
+                    << setw(12) << histogram.getCount()
+                    << setw(12) << histogram.percentile(50) / 1000.0
+                    << setw(12) << histogram.percentile(99) / 1000.0
+                    << setw(12) << histogram.getMax() / 1000.0 << "\n";
+            }
+        }
+        out << defaultfloat << left;
+    }
+};
+
+/**
+ * @brief Records the lifetime of a scope into the calling thread's histogram.
+ */
+class ScopedLatencyTimer {
+private:
+    ProbeId probe;
+    chrono::steady_clock::time_point start;
+
+public:
+    explicit ScopedLatencyTimer(ProbeId probe) : probe(probe), start(chrono::steady_clock::now()) {}
+    ~ScopedLatencyTimer() {
+        auto elapsed = chrono::steady_clock::now() - start;
+        LatencyProfiler::local().probes[probe].record(
+            static_cast<uint64_t>(chrono::duration_cast<chrono::nanoseconds>(elapsed).count()));
+    }
+};
+
+#ifdef SNAKE_PROFILE
+    #define PROFILE_CONCAT_INNER(a, b) a##b
+    #define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+    #define PROFILE_SCOPE(probe) ScopedLatencyTimer PROFILE_CONCAT(profileTimer_, __LINE__)(probe)
+    #define PROFILE_THREAD_NAME(name) LatencyProfiler::nameThread(name)
+#else
+    #define PROFILE_SCOPE(probe) ((void)0)
+    #define PROFILE_THREAD_NAME(name) ((void)0)
+#endif
+
+#endif // LATENCYPROFILER_H
@@ -0,0 +1,236 @@
+// level.h
+#ifndef LEVEL_H
+#define LEVEL_H
+
+#include "gameLogic.h"
+#include "mappedFile.h"
+#include <fstream>
+#include <string>
+
+// ============================================================================
+// LEVELS
+// ============================================================================
+
+/**
+ * @brief One level of a pack: a rows x cols wall layout.
+ *
+ * cells points into the pack (usually straight into the file mapping) and
+ * uses the Board's one-byte row-major layout, so it can be handed directly
+ * to SnakeGameLogic::initializeBoard() or SimulationConfig::layout.
+ */
+struct LevelView {
+    int rows = 0;
+    int cols = 0;
+    const CellType* cells = nullptr;
+};
+
+/**
+ * @brief Read-only set of levels, memory-mapped from a binary pack file.
+ *
+ * Binary form (little-endian, magic "SNKL"):
+ *   0   magic, u32 version (1), u32 level count, u32 reserved
+ *   16  one 16-byte entry per level: u32 rows, u32 cols, u64 offset
+ *   ... each level's rows * cols CellType bytes at its offset (64-byte aligned)
+ *
+ * open() maps the whole file and checks only the header and directory, so
+ * startup cost does not depend on the pack size: cell pages are faulted in
+ * when a level is first used, and every process or worker thread playing
+ * the same file shares the same page-cache pages.
+ *
+ * ASCII form, for authoring: '#' is a wall, '.' or ' ' is empty, short
+ * lines are padded with empty cells, and a line of dashes ("---") starts
+ * the next level. open() accepts it too (parsed into owned memory laid out
+ * like the binary form); writeBinary() converts it for fast loading. The
+ * snake's head starts on the centre cell, which must be empty.
+ */
+class LevelPack {
+private:
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t HEADER_SIZE = 16;
+    static constexpr size_t ENTRY_SIZE = 16;
+    static constexpr size_t MAX_SIDE = 10000;
+
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    MappedFile file;
+    vector<uint8_t> owned;           ///< Backing store for packs parsed from ASCII
+
+    static uint32_t getU32(const uint8_t* in) {
+        return in[0] | (in[1] << 8) | (in[2] << 16) | (static_cast<uint32_t>(in[3]) << 24);
+    }
+
+    static void putU32(uint8_t* out, uint32_t value) {
+        for (int i = 0; i < 4; i++) out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+
+    void unmap() {
+        file.close();
+        owned.clear();
+        data = nullptr;
+        size = 0;
+    }
+
+    /**
+     * @brief Checks the header and directory of the data in data/size.
+     * @param error Receives the reason on failure
+     * @return True if every level lies inside the data and starts on an empty cell
+     */
+    bool validate(string& error) const {
+        if (size < HEADER_SIZE || memcmp(data, "SNKL", 4) != 0 || getU32(data + 4) != VERSION) {
+            error = "not a level pack";
+            return false;
+        }
+        uint32_t count = getU32(data + 8);
+        if (count == 0 || count > (size - HEADER_SIZE) / ENTRY_SIZE) {
+            error = "bad level count";
+            return false;
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            const uint8_t* entry = data + HEADER_SIZE + i * ENTRY_SIZE;
+            uint64_t rows = getU32(entry);
+            uint64_t cols = getU32(entry + 4);
+            uint64_t offset = getU32(entry + 8) | (static_cast<uint64_t>(getU32(entry + 12)) << 32);
+            if (rows < 1 || cols < 1 || rows > MAX_SIDE || cols > MAX_SIDE ||
+                offset > size || rows * cols > size - offset) {
+                error = "level " + to_string(i) + " is out of bounds";
+                return false;
+            }
+            if (data[offset + (rows / 2) * cols + cols / 2] == WALL) {
+                error = "level " + to_string(i) + " has a wall on its centre (start) cell";
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Parses the ASCII form into the binary layout.
+     * @param text Whole file contents
+     * @param out Receives the binary pack
+     * @param error Receives the reason on failure
+     * @return True on success
+     */
+    static bool parseAscii(const string& text, vector<uint8_t>& out, string& error) {
+        vector<vector<string>> levels(1);
+        size_t start = 0;
+        for (int lineNumber = 1; start < text.size(); lineNumber++) {
+            size_t end = text.find('\n', start);
+            if (end == string::npos) end = text.size();
+            string line = text.substr(start, end - start);
+            start = end + 1;
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+
+            if (!line.empty() && line.find_first_not_of('-') == string::npos) {
+                if (!levels.back().empty()) levels.emplace_back();
+                continue;
+            }
+            if (line.find_first_not_of("#. ") != string::npos) {
+                error = "line " + to_string(lineNumber) + ": only '#', '.' and ' ' are allowed";
+                return false;
+            }
+            levels.back().push_back(line);
+        }
+        if (levels.back().empty()) levels.pop_back();
+        if (levels.empty()) {
+            error = "no levels";
+            return false;
+        }
+
+        size_t offset = HEADER_SIZE + levels.size() * ENTRY_SIZE;
+        out.assign(offset, 0);
+        memcpy(out.data(), "SNKL", 4);
+        putU32(out.data() + 4, VERSION);
+        putU32(out.data() + 8, static_cast<uint32_t>(levels.size()));
+        for (size_t i = 0; i < levels.size(); i++) {
+            const vector<string>& lines = levels[i];
+            size_t cols = 0;
+            for (const string& line : lines) cols = max(cols, line.size());
+            if (cols == 0 || lines.size() > MAX_SIDE || cols > MAX_SIDE) {
+                error = "level " + to_string(i) + " is empty or too large";
+                return false;
+            }
+
+            offset = (out.size() + 63) & ~size_t(63);
+            uint8_t* entry = out.data() + HEADER_SIZE + i * ENTRY_SIZE;
+            putU32(entry, static_cast<uint32_t>(lines.size()));
+            putU32(entry + 4, static_cast<uint32_t>(cols));
+            putU32(entry + 8, static_cast<uint32_t>(offset));
+            putU32(entry + 12, static_cast<uint32_t>(static_cast<uint64_t>(offset) >> 32));
+
+            out.resize(offset + lines.size() * cols, EMPTY);
+            for (size_t r = 0; r < lines.size(); r++) {
+                for (size_t c = 0; c < lines[r].size(); c++) {
+                    out[offset + r * cols + c] = lines[r][c] == '#' ? WALL : EMPTY;
+                }
+            }
+        }
+        return true;
+    }
+
+public:
+    LevelPack() = default;
+    LevelPack(const LevelPack&) = delete;
+    LevelPack& operator=(const LevelPack&) = delete;
+    ~LevelPack() { unmap(); }
+
+    /**
+     * @brief Opens a pack in binary (mapped) or ASCII (parsed) form.
+     * @param path Level file
+     * @param error Receives the reason on failure
+     * @return False (pack left empty) if the file is unreadable or malformed
+     */
+    bool open(const string& path, string& error) {
+        unmap();
+        if (!file.open(path)) {
+            error = "cannot read " + path;
+            return false;
+        }
+        data = file.getData();
+        size = file.getSize();
+
+        if (size < 4 || memcmp(data, "SNKL", 4) != 0) {
+            string text(reinterpret_cast<const char*>(data), size);
+            unmap();
+            if (!parseAscii(text, owned, error)) {
+                error = path + ": " + error;
+                return false;
+            }
+            data = owned.data();
+            size = owned.size();
+        }
+
+        if (!validate(error)) {
+            error = path + ": " + error;
+            unmap();
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Writes the pack in binary form, ready to be mapped.
+     * @param path Destination path (overwritten)
+     * @return True on success
+     */
+    bool writeBinary(const string& path) const {
+        ofstream out(path, ios::binary);
+        out.write(reinterpret_cast<const char*>(data), static_cast<streamsize>(size));
+        return static_cast<bool>(out);
+    }
+
+    size_t getLevelCount() const { return data ? getU32(data + 8) : 0; }
+
+    /**
+     * @brief Gets a level without copying its cells.
+     * @param index Level in [0, getLevelCount())
+     * @return View into the pack, valid while the pack stays open
+     */
+    LevelView getLevel(size_t index) const {
+        const uint8_t* entry = data + HEADER_SIZE + index * ENTRY_SIZE;
+        uint64_t offset = getU32(entry + 8) | (static_cast<uint64_t>(getU32(entry + 12)) << 32);
+        return {static_cast<int>(getU32(entry)), static_cast<int>(getU32(entry + 4)),
+                reinterpret_cast<const CellType*>(data + offset)};
+    }
+};
+
+#endif // LEVEL_H
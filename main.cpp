@@ -1,10 +1,22 @@
 #include "gameLogic.h"
+#include "replay.h"
+#include "hamiltonianPolicy.h"
+#include "level.h"
+#include "spectatorServer.h"
+#include "scoreLog.h"
+#include "consoleScreen.h"
+#include "frameRenderer.h"
 #include <iostream>
 #include <thread>
 #include <chrono>
 #include <sstream>
 #include <iomanip>
 #include <fstream>
+#include <string>
+#include <charconv>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
 
 #ifdef _WIN32
     #include <conio.h>
@@ -14,6 +26,7 @@
     #include <termios.h>
     #include <fcntl.h>
     #include <sys/ioctl.h>
+    #include <poll.h>
     #include <cstring>
 #endif
 
@@ -23,43 +36,41 @@ using namespace std;
 // High Score Manager
 // ============================================
 
+// Every finished game goes to an append-only log (written by a background
+// thread); the best player games are read back from it at startup
 class HighScoreManager {
 private:
-    const string filename = "game_highest.txt";
+    const string legacyFilename = "game_highest.txt";   // Best score from before the log
+    ScoreLog scoreLog;
+    Leaderboard leaderboard;
     int highScore;
     
 public:
-    HighScoreManager() : highScore(0) {
-        loadHighScore();
+    HighScoreManager() : scoreLog("game_scores.log"), leaderboard(3), highScore(0) {
+        scoreLog.load([this](const GameRecord& record) { leaderboard.offer(record); });
+        
+        int legacyScore = 0;
+        ifstream legacy(legacyFilename);
+        legacy >> legacyScore;
+        highScore = max(leaderboard.getBestScore(), legacyScore);
     }
     
-    void loadHighScore() {
-        ifstream file(filename);
-        if (file.is_open()) {
-            file >> highScore;
-            file.close();
-        } else {
-            highScore = 0;
-        }
-    }
-    
-    void saveHighScore(int score) {
-        if (score > highScore) {
-            highScore = score;
-            ofstream file(filename);
-            if (file.is_open()) {
-                file << highScore;
-                file.close();
-            }
-        }
+    // Queues the game for the log, so it never waits on the disk; true if
+    // a player game beat the previous high score
+    bool recordGame(const GameRecord& record) {
+        scoreLog.append(record);
+        leaderboard.offer(record);
+        if (record.mode != 0 || record.score <= highScore) return false;
+        highScore = record.score;
+        return true;
     }
     
     int getHighScore() const {
         return highScore;
     }
     
-    bool isNewHighScore(int score) const {
-        return score > highScore;
+    const Leaderboard& getLeaderboard() const {
+        return leaderboard;
     }
 };
 
@@ -67,64 +78,38 @@ public:
 // Platform-Independent Terminal Control
 // ============================================
 
+// Keyboard input and terminal modes; all output goes through ConsoleScreen
 class TerminalController {
 private:
 #ifndef _WIN32
     termios originalSettings;
     bool settingsChanged = false;
     int originalFlags = 0;
-#endif
-
-public:
-    void clearScreen() {
-#ifdef _WIN32
-        system("cls");
+    int wakePipe[2] = {-1, -1};     // Lets interruptWait() break out of poll()
 #else
-        // LINUX FIX: Use \033[H\033[J instead of \033[2J\033[1;1H for more reliable clearing
-        // \033[H moves cursor to home, \033[J clears from cursor to end of screen
-        cout << "\033[H\033[J";
-        cout.flush();
-        // LINUX FIX: Small delay to ensure terminal processes the escape sequence
-        this_thread::sleep_for(chrono::milliseconds(10));
-#endif
-    }
-    
-    void setCursorPosition(int row, int col) {
-#ifdef _WIN32
-        COORD pos = {(SHORT)col, (SHORT)row};
-        SetConsoleCursorPosition(GetStdHandle(STD_OUTPUT_HANDLE), pos);
-#else
-        cout << "\033[" << (row + 1) << ";" << (col + 1) << "H";
-        // LINUX FIX: Always flush after cursor positioning to prevent artifacts
-        cout.flush();
-#endif
+    HANDLE wakeEvent = NULL;
+    
+    // Console input handles also signal for focus, mouse and key-up events;
+    // drop those so a wait does not spin on them
+    void discardNonKeyEvents() {
+        HANDLE inputHandle = GetStdHandle(STD_INPUT_HANDLE);
+        INPUT_RECORD record;
+        DWORD count = 0;
+        while (PeekConsoleInput(inputHandle, &record, 1, &count) && count > 0) {
+            if (record.EventType == KEY_EVENT && record.Event.KeyEvent.bKeyDown) break;
+            ReadConsoleInput(inputHandle, &record, 1, &count);
+        }
     }
-    
-    void hideCursor() {
-#ifdef _WIN32
-        HANDLE consoleHandle = GetStdHandle(STD_OUTPUT_HANDLE);
-        CONSOLE_CURSOR_INFO info;
-        info.dwSize = 100;
-        info.bVisible = FALSE;
-        SetConsoleCursorInfo(consoleHandle, &info);
-#else
-        cout << "\033[?25l";
-        // LINUX FIX: Flush to ensure cursor hide command is processed immediately
-        cout.flush();
 #endif
-    }
-    
-    void showCursor() {
+
+public:
+    TerminalController() {
 #ifdef _WIN32
-        HANDLE consoleHandle = GetStdHandle(STD_OUTPUT_HANDLE);
-        CONSOLE_CURSOR_INFO info;
-        info.dwSize = 100;
-        info.bVisible = TRUE;
-        SetConsoleCursorInfo(consoleHandle, &info);
+        wakeEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
 #else
-        cout << "\033[?25h";
-        // LINUX FIX: Flush to ensure cursor show command is processed immediately
-        cout.flush();
+        if (pipe(wakePipe) == 0) {
+            fcntl(wakePipe[0], F_SETFL, fcntl(wakePipe[0], F_GETFL, 0) | O_NONBLOCK);
+        }
 #endif
     }
     
@@ -154,6 +139,42 @@ public:
 #endif
     }
     
+    // Blocks until input is readable, the timeout expires (-1 waits forever)
+    // or interruptWait() is called; returns true only if input is readable
+    bool waitForInput(int timeoutMs) {
+#ifdef _WIN32
+        HANDLE handles[2] = {GetStdHandle(STD_INPUT_HANDLE), wakeEvent};
+        DWORD result = WaitForMultipleObjects(2, handles, FALSE, 
+                                              timeoutMs < 0 ? INFINITE : (DWORD)timeoutMs);
+        if (result != WAIT_OBJECT_0) return false;
+        if (_kbhit()) return true;
+        discardNonKeyEvents();
+        return false;
+#else
+        pollfd fds[2] = {{STDIN_FILENO, POLLIN, 0}, {wakePipe[0], POLLIN, 0}};
+        int ready = poll(fds, wakePipe[0] >= 0 ? 2 : 1, timeoutMs);
+        if (ready <= 0) return false;
+        if (wakePipe[0] >= 0 && (fds[1].revents & POLLIN)) {
+            char drain[16];
+            while (read(wakePipe[0], drain, sizeof(drain)) > 0) {}
+            return false;
+        }
+        return (fds[0].revents & POLLIN) != 0;
+#endif
+    }
+    
+    // Wakes a thread blocked in waitForInput()
+    void interruptWait() {
+#ifdef _WIN32
+        SetEvent(wakeEvent);
+#else
+        if (wakePipe[1] >= 0) {
+            char wake = 1;
+            (void)write(wakePipe[1], &wake, 1);
+        }
+#endif
+    }
+    
     bool kbhit() {
 #ifdef _WIN32
         return _kbhit() != 0;
@@ -176,7 +197,12 @@ public:
     
     ~TerminalController() {
         disableRawMode();
-        showCursor();
+#ifdef _WIN32
+        if (wakeEvent) CloseHandle(wakeEvent);
+#else
+        if (wakePipe[0] >= 0) close(wakePipe[0]);
+        if (wakePipe[1] >= 0) close(wakePipe[1]);
+#endif
     }
 };
 
@@ -186,18 +212,49 @@ public:
 
 class GameRenderer {
 private:
-    TerminalController& terminal;
+    ConsoleScreen& screen;
     HighScoreManager& highScoreManager;
     int headerRows = 6;
     int footerRows = 2;
+    int screenRows = 0;            // Terminal height if known, else 0
+    uint64_t renderedGeneration = 0; // Snapshot on screen
+    FrameRenderer frame;           // Board cache and box template
     
 public:
-    GameRenderer(TerminalController& term, HighScoreManager& hsm) 
-        : terminal(term), highScoreManager(hsm) {}
+    GameRenderer(ConsoleScreen& screen, HighScoreManager& hsm) 
+        : screen(screen), highScoreManager(hsm) {}
+    
+    // Lets the layout keep the instructions and game over box on screen
+    void setScreenRows(int rows) {
+        screenRows = rows;
+    }
+    
+    // Largest board whose frame, header and controls line fit the screen
+    pair<int, int> fitBoard(int rows, int cols) const {
+        return {max(4, rows - headerRows - footerRows - 2), max(10, cols - 2)};
+    }
+    
+    // Folds the latest tick's deltas into the cache; called after every
+    // update() so frames that span several ticks still redraw only the
+    // cells those ticks changed
+    void collectChanges(const SnakeGameLogic& game) {
+        auto state = game.getGameState();
+        frame.sync(*state);
+    }
     
+    // Once per game: the only place the renderer allocates (a new board
+    // size rebuilds the frame template), so the per-tick path never does.
+    // Title, board, score and controls are staged and shown as one frame
     void drawFullScreen(const SnakeGameLogic& game, bool showInstructions = false) {
     auto state = game.getGameState();
     
+    if (frame.getRows() != state->rows || frame.getCols() != state->cols) {
+        frame.layout(state->rows, state->cols, 4, headerRows);
+    } else {
+        frame.invalidate();
+    }
+    frame.sync(*state);
+    
     ostringstream buffer;
     
     // Title
@@ -206,28 +263,20 @@ public:
     buffer << "  |       SNAKE GAME              |\n";
     buffer << "  +===============================+\n\n";
     
-    // REMOVED: Do NOT add score line here - it's handled separately by updateGameBoard()
-    
-    // Game board
-    buffer << "+";
-    for (int i = 0; i < state->cols; i++) buffer << "-";
-    buffer << "+\n";
+    screen.clear();
+    screen.write(0, 0, buffer.str());
     
-    for (int r = 0; r < state->rows; r++) {
-        buffer << "|";
-        for (int c = 0; c < state->cols; c++) {
-            buffer << " ";
-        }
-        buffer << "|\n";
-    }
+    // Board box and score line from the frame template
+    frame.draw(*state, highScoreManager.getHighScore(), screen);
+    renderedGeneration = state->generation;
     
-    buffer << "+";
-    for (int i = 0; i < state->cols; i++) buffer << "-";
-    buffer << "+\n";
-    
-    // Controls section
+    // Controls section (the full box only if it fits under the board)
+    buffer.str("");
     buffer << "\n";
-    if (showInstructions) {
+    bool roomForInstructions = screenRows == 0 || headerRows + state->rows + 14 <= screenRows;
+    if (showInstructions && !roomForInstructions) {
+        buffer << "  Controls: Arrow Keys or WASD  |  Q: Quit  |  Press any key to start...\n";
+    } else if (showInstructions) {
         buffer << "  +===================================+\n";
         buffer << "  |  CONTROLS:                        |\n";
         buffer << "  |                                   |\n";
@@ -243,78 +292,26 @@ public:
         buffer << "  Controls: Arrow Keys or WASD  |  Q: Quit\n";
     }
     
-    terminal.clearScreen();
-    terminal.hideCursor();
-    cout << buffer.str();
-    cout.flush();
-    
-    // NOW output the score after the static board
-    terminal.setCursorPosition(4, 0);
-    ostringstream scoreBuffer;
-    scoreBuffer << "  Score: " << setw(4) << state->score 
-                << "  |  Length: " << setw(3) << state->snakeLength 
-                << "  |  High Score: " << setw(4) << highScoreManager.getHighScore() << "  ";
-    cout << scoreBuffer.str();
-    cout.flush();
+    screen.write(headerRows + state->rows + 1, 0, buffer.str());
+    screen.present();
 }
 
     
     void updateGameBoard(const SnakeGameLogic& game) {
         auto state = game.getGameState();
         
-        // LINUX FIX: Build score line in buffer first, then output atomically
-        ostringstream scoreBuffer;
-        scoreBuffer << "  Score: " << setw(4) << state->score 
-                    << "  |  Length: " << setw(3) << state->snakeLength 
-                    << "  |  High Score: " << setw(4) << highScoreManager.getHighScore() << "  ";
-        
-        // Update score
-        terminal.setCursorPosition(4, 0);
-        cout << scoreBuffer.str();
-        cout.flush();
-        
-        // LINUX FIX: Build each row in a buffer before outputting to reduce flicker
-        for (int r = 0; r < state->rows; r++) {
-            ostringstream rowBuffer;
-            terminal.setCursorPosition(headerRows + r, 1);
-            
-            for (int c = 0; c < state->cols; c++) {
-                int cellType = state->board[r][c];
-                
-                switch(cellType) {
-                    case 0: // EMPTY
-                        rowBuffer << " ";
-                        break;
-                    case 1: // SNAKE
-                        if (r == state->snake.front().first && 
-                            c == state->snake.front().second) {
-                            rowBuffer << "O"; // Head
-                        } else {
-                            rowBuffer << "o"; // Body
-                        }
-                        break;
-                    case 2: // FOOD
-                        rowBuffer << "*";
-                        break;
-                    case 3: // WALL
-                        rowBuffer << "#";
-                        break;
-                    default:
-                        rowBuffer << " ";
-                }
-            }
-            
-            // LINUX FIX: Output entire row at once
-            cout << rowBuffer.str();
-        }
-        
-        // LINUX FIX: Single flush after all updates
-        cout.flush();
+        // Frames run faster than ticks; skip those with nothing new
+        if (state->generation == renderedGeneration) return;
+        PROFILE_SCOPE(PROBE_RENDER);
+        renderedGeneration = state->generation;
+        frame.sync(*state);
+        frame.draw(*state, highScoreManager.getHighScore(), screen);
+        screen.present();
     }
     
-    void showGameOver(const SnakeGameLogic& game) {
+    // The game was already recorded; newHighScore is what that reported
+    void showGameOver(const SnakeGameLogic& game, bool newHighScore) {
         auto state = game.getGameState();
-        highScoreManager.saveHighScore(state->score);
         
         // LINUX FIX: Build game over message in buffer for atomic output
         ostringstream buffer;
@@ -324,7 +321,7 @@ public:
         buffer << "  |   Final Score: " << setw(4) << state->score << "          |\n";
         buffer << "  |   High Score:  " << setw(4) << highScoreManager.getHighScore() << "          |\n";
         
-        if (highScoreManager.isNewHighScore(state->score) && state->score > 0) {
+        if (newHighScore) {
             buffer << "  |                               |\n";
             buffer << "  |   *** NEW HIGH SCORE! ***     |\n";
         }
@@ -334,10 +331,13 @@ public:
         buffer << "  |   Press Q to Quit             |\n";
         buffer << "  +===============================+\n";
         
+        // Below the board, or over its bottom if that would run off screen
         int messageRow = headerRows + state->rows + 3;
-        terminal.setCursorPosition(messageRow, 0);
-        cout << buffer.str();
-        cout.flush();
+        if (screenRows > 0) {
+            messageRow = max(0, min(messageRow, screenRows - 12));
+        }
+        screen.write(messageRow, 0, buffer.str());
+        screen.present();
     }
 };
 
@@ -345,67 +345,69 @@ public:
 // Input Handler
 // ============================================
 
+// Runs on its own thread while a game is active: blocks in
+// TerminalController::waitForInput, decodes keys and pushes directions
+// straight into the game, so input never waits for the game loop
 class InputHandler {
 private:
     TerminalController& terminal;
     SnakeGameLogic& game;
     char buffer[3];
     int bufferPos = 0;
-    
-public:
-    InputHandler(TerminalController& term, SnakeGameLogic& g) 
-        : terminal(term), game(g) {
-        memset(buffer, 0, sizeof(buffer));
+    thread worker;
+    atomic<bool> running{false};
+    atomic<bool> quit{false};
+    atomic<bool> profileDumpRequested{false};
+    bool acceptDirections;           // False in the demo modes, whose policy is the only direction producer
+    
+    // DirectionController's ring takes one producer; in the demo modes that
+    // is the policy on the logic thread, so keys only quit (or profile)
+    void turn(Direction dir) {
+        if (acceptDirections) game.setDirection(dir);
     }
     
-    char getKey() {
-        if (!terminal.kbhit()) return 0;
-        return terminal.getch();
+    // Reads the rest of an escape sequence, waiting briefly for each byte
+    // instead of spinning
+    void readEscapeSequence() {
+        buffer[0] = 27;
+        bufferPos = 1;
+        
+        // LINUX FIX: 20ms timeout per byte for reliable arrow key detection
+        while (bufferPos < 3 && terminal.waitForInput(20)) {
+            buffer[bufferPos++] = terminal.getch();
+        }
+        
+        // Check if we have a complete arrow key sequence
+        if (bufferPos >= 3 && buffer[0] == 27 && buffer[1] == '[') {
+            switch(buffer[2]) {
+                case 'A': turn(SnakeGameLogic::getDirectionUp()); break;
+                case 'B': turn(SnakeGameLogic::getDirectionDown()); break;
+                case 'C': turn(SnakeGameLogic::getDirectionRight()); break;
+                case 'D': turn(SnakeGameLogic::getDirectionLeft()); break;
+            }
+        }
+        
+        // Reset buffer
+        memset(buffer, 0, sizeof(buffer));
+        bufferPos = 0;
     }
     
-    char pollInput() {
-        char key = getKey();
-        if (key == 0) return 0;
-        
+    char handleKey(char key) {
         // Handle arrow keys (platform-specific)
 #ifdef _WIN32
         if (key == -32 || key == 0) { // Arrow key prefix on Windows
             key = terminal.getch();
             switch(key) {
-                case 72: game.setDirection(SnakeGameLogic::getDirectionUp()); break;
-                case 80: game.setDirection(SnakeGameLogic::getDirectionDown()); break;
-                case 75: game.setDirection(SnakeGameLogic::getDirectionLeft()); break;
-                case 77: game.setDirection(SnakeGameLogic::getDirectionRight()); break;
+                case 72: turn(SnakeGameLogic::getDirectionUp()); break;
+                case 80: turn(SnakeGameLogic::getDirectionDown()); break;
+                case 75: turn(SnakeGameLogic::getDirectionLeft()); break;
+                case 77: turn(SnakeGameLogic::getDirectionRight()); break;
             }
             return 0;
         }
 #else
         if (key == 27) { // Escape sequence start
-            buffer[0] = key;
-            bufferPos = 1;
-            
-            // LINUX FIX: Increased timeout to 20ms for more reliable arrow key detection
-            auto startTime = chrono::steady_clock::now();
-            while (bufferPos < 3 && chrono::duration_cast<chrono::milliseconds>(
-                   chrono::steady_clock::now() - startTime).count() < 20) {
-                if (terminal.kbhit()) {
-                    buffer[bufferPos++] = terminal.getch();
-                }
-            }
-            
-            // Check if we have a complete arrow key sequence
-            if (bufferPos >= 3 && buffer[0] == 27 && buffer[1] == '[') {
-                switch(buffer[2]) {
-                    case 'A': game.setDirection(SnakeGameLogic::getDirectionUp()); break;
-                    case 'B': game.setDirection(SnakeGameLogic::getDirectionDown()); break;
-                    case 'C': game.setDirection(SnakeGameLogic::getDirectionRight()); break;
-                    case 'D': game.setDirection(SnakeGameLogic::getDirectionLeft()); break;
-                }
-            }
-            
-            // Reset buffer
-            memset(buffer, 0, sizeof(buffer));
-            bufferPos = 0;
+            readEscapeSequence();
             return 0;
         }
 #endif
@@ -413,24 +415,74 @@ public:
         // WASD and quit
         switch(key) {
             case 'w': case 'W':
-                game.setDirection(SnakeGameLogic::getDirectionUp());
+                turn(SnakeGameLogic::getDirectionUp());
                 return 0;
             case 's': case 'S':
-                game.setDirection(SnakeGameLogic::getDirectionDown());
+                turn(SnakeGameLogic::getDirectionDown());
                 return 0;
             case 'a': case 'A':
-                game.setDirection(SnakeGameLogic::getDirectionLeft());
+                turn(SnakeGameLogic::getDirectionLeft());
                 return 0;
             case 'd': case 'D':
-                game.setDirection(SnakeGameLogic::getDirectionRight());
+                turn(SnakeGameLogic::getDirectionRight());
                 return 0;
             case 'q': case 'Q':
                 return 'Q';
+#ifdef SNAKE_PROFILE
+            case 'p': case 'P':
+                profileDumpRequested.store(true, memory_order_release);
+                return 0;
+#endif
             default:
                 return 0;
         }
     }
     
+    void readLoop() {
+        PROFILE_THREAD_NAME("input");
+        while (running.load(memory_order_acquire)) {
+            if (!terminal.waitForInput(-1)) continue;
+            while (running.load(memory_order_relaxed) && terminal.kbhit()) {
+                PROFILE_SCOPE(PROBE_INPUT);
+                if (handleKey(terminal.getch()) == 'Q') {
+                    quit.store(true, memory_order_release);
+                }
+            }
+        }
+    }
+    
+public:
+    InputHandler(TerminalController& term, SnakeGameLogic& g, bool acceptDirections = true) 
+        : terminal(term), game(g), acceptDirections(acceptDirections) {
+        memset(buffer, 0, sizeof(buffer));
+    }
+    
+    ~InputHandler() {
+        stop();
+    }
+    
+    void start() {
+        if (running.exchange(true)) return;
+        quit.store(false, memory_order_relaxed);
+        worker = thread(&InputHandler::readLoop, this);
+    }
+    
+    void stop() {
+        if (!running.exchange(false)) return;
+        terminal.interruptWait();
+        worker.join();
+    }
+    
+    bool quitRequested() const {
+        return quit.load(memory_order_acquire);
+    }
+    
+    // True once per press of the profiling hotkey (P, profiling builds only)
+    bool takeProfileDumpRequest() {
+        return profileDumpRequested.exchange(false, memory_order_acq_rel);
+    }
+    
+    // Only call while the input thread is stopped
     void clearBuffer() {
         while (terminal.kbhit()) {
             terminal.getch();
@@ -440,11 +492,151 @@ public:
     }
 };
 
+// ============================================
+// Game Configuration
+// ============================================
+
+// Session settings: defaults below, then an optional "key = value" file
+// (--config FILE, # starts a comment), then --key value on the command line.
+// Keys match the flags without the dashes.
+struct GameConfig {
+    int rows = 20;                   // 0 = fit the terminal
+    int cols = 40;                   // 0 = fit the terminal
+    int tickMs = 150;                // Tick interval at score 0
+    int minTickMs = 40;              // Fastest tick the speed-up curve reaches
+    double speedup = 0.0;            // Percent the tick shrinks per food eaten
+    int renderRate = 60;             // Frames per second, independent of ticks
+    int startingLength = 3;
+    int pointsPerFood = 10;
+    string recordPath;               // Save each finished game here if set
+    string levelPath;                // Level pack to play on; overrides rows and cols
+    int levelIndex = 0;
+    int servePort = 0;               // Stream games to spectators on this TCP port if set
+    
+    // Tick interval after foodsEaten foods: a geometric curve, floored at
+    // minTickMs (or tickMs if that is already faster)
+    chrono::microseconds tickInterval(int foodsEaten) const {
+        double interval = tickMs * 1000.0 * pow(1.0 - speedup / 100.0, foodsEaten);
+        double floor = min(tickMs, minTickMs) * 1000.0;
+        return chrono::microseconds(static_cast<long long>(max(interval, floor)));
+    }
+    
+    // Applies one setting; false for an unknown key or a bad value
+    bool set(const string& key, const string& value) {
+        auto parseInt = [&](int& field, int low, int high) {
+            char* end = nullptr;
+            long parsed = strtol(value.c_str(), &end, 10);
+            if (value.empty() || *end != '\0' || parsed < low || parsed > high) return false;
+            field = static_cast<int>(parsed);
+            return true;
+        };
+        
+        if (key == "rows" || key == "cols") {
+            int& field = key == "rows" ? rows : cols;
+            if (value == "fit") {
+                field = 0;
+                return true;
+            }
+            return parseInt(field, 2, 10000);
+        }
+        if (key == "tick-ms") return parseInt(tickMs, 1, 10000);
+        if (key == "min-tick-ms") return parseInt(minTickMs, 1, 10000);
+        if (key == "fps") return parseInt(renderRate, 1, 1000);
+        if (key == "length") return parseInt(startingLength, 1, 10000);
+        if (key == "points") return parseInt(pointsPerFood, 0, 1000000);
+        if (key == "record") {
+            recordPath = value;
+            return !value.empty();
+        }
+        if (key == "level") {
+            levelPath = value;
+            return !value.empty();
+        }
+        if (key == "level-index") return parseInt(levelIndex, 0, 1000000);
+        if (key == "serve") return parseInt(servePort, 1, 65535);
+        if (key == "speedup") {
+            char* end = nullptr;
+            double parsed = strtod(value.c_str(), &end);
+            if (value.empty() || *end != '\0' || !(parsed >= 0.0 && parsed < 100.0)) return false;
+            speedup = parsed;
+            return true;
+        }
+        return false;
+    }
+    
+    bool loadFile(const string& path, string& error) {
+        ifstream file(path);
+        if (!file) {
+            error = "cannot read " + path;
+            return false;
+        }
+        
+        string line;
+        for (int lineNumber = 1; getline(file, line); lineNumber++) {
+            line = line.substr(0, line.find('#'));
+            size_t equals = line.find('=');
+            string key = trim(line.substr(0, equals));
+            if (key.empty() && equals == string::npos) continue;
+            
+            string value = equals == string::npos ? "" : trim(line.substr(equals + 1));
+            if (!set(key, value)) {
+                error = path + ":" + to_string(lineNumber) + ": bad setting '" + trim(line) + "'";
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    // Reads --config first so command-line flags override the file
+    bool parseArgs(int argc, char** argv, string& error) {
+        for (int i = 1; i + 1 < argc; i++) {
+            if (string(argv[i]) == "--config" && !loadFile(argv[i + 1], error)) return false;
+        }
+        for (int i = 1; i < argc; i += 2) {
+            string flag = argv[i];
+            if (flag.size() < 3 || flag.compare(0, 2, "--") != 0 || i + 1 >= argc) {
+                error = "bad argument '" + flag + "'";
+                return false;
+            }
+            if (flag == "--config") continue;
+            if (!set(flag.substr(2), argv[i + 1])) {
+                error = "bad value for " + flag + ": '" + argv[i + 1] + "'";
+                return false;
+            }
+        }
+        return true;
+    }
+    
+private:
+    static string trim(const string& text) {
+        size_t first = text.find_first_not_of(" \t\r");
+        if (first == string::npos) return "";
+        return text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+    }
+};
+
+static void printUsage(const char* program) {
+    cerr << "Usage: " << program << " [options]\n"
+         << "  --config FILE       Read \"key = value\" settings (keys as below, without --)\n"
+         << "  --rows R | fit      Board rows; fit sizes the board to the terminal (default 20)\n"
+         << "  --cols C | fit      Board columns (default 40)\n"
+         << "  --tick-ms T         Milliseconds per tick at the start (default 150)\n"
+         << "  --speedup P         Tick shrinks by P percent per food eaten (default 0)\n"
+         << "  --min-tick-ms T     Fastest tick the speed-up reaches (default 40)\n"
+         << "  --fps F             Render rate (default 60)\n"
+         << "  --length L          Starting snake length (default 3)\n"
+         << "  --points N          Points per food (default 10)\n"
+         << "  --record FILE       Save each finished game for snake_headless --replay\n"
+         << "  --level FILE        Play on a level pack ('#' walls); sets the board size\n"
+         << "  --level-index N     Level of the pack to play (default 0)\n"
+         << "  --serve PORT        Stream every game to TCP spectators (POSIX)\n";
+}
+
 // ============================================
 // Main Menu
 // ============================================
 
-void showIntro(TerminalController& terminal, HighScoreManager& highScoreManager) {
+void showIntro(ConsoleScreen& screen, HighScoreManager& highScoreManager) {
     // LINUX FIX: Build intro screen in buffer for atomic output
     ostringstream buffer;
     buffer << "\n\n\n";
@@ -453,45 +645,148 @@ void showIntro(TerminalController& terminal, HighScoreManager& highScoreManager)
     buffer << "  #          SNAKE GAME                   #\n";
     buffer << "  #                                       #\n";
     buffer << "  #########################################\n\n";
-    buffer << "  High Score: " << highScoreManager.getHighScore() << "\n\n\n";
+    buffer << "  High Score: " << highScoreManager.getHighScore() << "\n";
+    for (const GameRecord& record : highScoreManager.getLeaderboard().getEntries()) {
+        buffer << "    " << setw(6) << record.score << "  length " << setw(4) << record.length
+               << "  " << setw(4) << record.durationMs / 1000 << " s\n";
+    }
+    buffer << "\n\n";
     buffer << "  Press ENTER to Start\n";
+    buffer << "  Press A to watch the Autopilot\n";
+    buffer << "  Press H to watch a perfect game\n";
     buffer << "  Press Q to Quit\n\n";
     
-    terminal.clearScreen();
-    cout << buffer.str();
-    cout.flush();
+    screen.clear();
+    screen.write(0, 0, buffer.str());
+    screen.present();
 }
 
+// ============================================
+// Game Loop Scheduler
+// ============================================
+
+// Fixed-timestep clock: ticks are due every tickInterval measured from the
+// start, not from when the previous tick happened to run, so polling jitter
+// never accumulates. Late ticks are caught up (bounded by maxCatchUpTicks
+// to avoid a spiral after a long stall). Rendering has its own rate.
+class FixedStepScheduler {
+private:
+    using Clock = chrono::steady_clock;
+    
+    Clock::duration tickInterval;
+    Clock::duration renderInterval;
+    Clock::time_point nextTick;
+    Clock::time_point nextRender;
+    int maxCatchUpTicks;
+    
+public:
+    FixedStepScheduler(chrono::microseconds tickInterval, chrono::microseconds renderInterval,
+                       int maxCatchUpTicks = 5)
+        : tickInterval(tickInterval), renderInterval(renderInterval), 
+          maxCatchUpTicks(maxCatchUpTicks) {}
+    
+    void start(Clock::time_point now) {
+        nextTick = now + tickInterval;
+        nextRender = now;
+    }
+    
+    // Takes effect from the tick after the one already scheduled
+    void setTickInterval(Clock::duration interval) {
+        tickInterval = interval;
+    }
+    
+    // Number of logic ticks due at 'now'; advances the tick deadline
+    int ticksDue(Clock::time_point now) {
+        int due = 0;
+        while (nextTick <= now && due < maxCatchUpTicks) {
+            nextTick += tickInterval;
+            due++;
+        }
+        if (nextTick <= now) {
+            // Too far behind: drop the backlog and resume on schedule
+            nextTick = now + tickInterval;
+        }
+        return due;
+    }
+    
+    // True when a frame is due at 'now'; advances the render deadline
+    bool renderDue(Clock::time_point now) {
+        if (now < nextRender) return false;
+        nextRender += renderInterval;
+        if (nextRender <= now) nextRender = now + renderInterval;
+        return true;
+    }
+    
+    Clock::time_point nextDeadline() const {
+        return min(nextTick, nextRender);
+    }
+};
+
 // ============================================
 // Game Loop
 // ============================================
 
-bool runGame(TerminalController& terminal, HighScoreManager& highScoreManager) {
-    SnakeGameLogic game;
-    GameRenderer renderer(terminal, highScoreManager);
-    
-    // Game configuration (single difficulty)
-    int rows = 20;
-    int cols = 40;
-    int updateDelay = 150;
-    int startingLength = 3;
-    int pointsPerFood = 10;
+// Who steers the snake; the demo modes play themselves (Q still quits)
+enum PlayMode {
+    PLAYER_MODE,
+    AUTOPILOT_MODE,                  // Pathfinding bot (attract mode)
+    CYCLE_MODE                       // Hamiltonian cycle, always fills the board
+};
+
+bool runGame(TerminalController& terminal, ConsoleScreen& screen, HighScoreManager& highScoreManager,
+             const GameConfig& config, PlayMode mode, const LevelView* level, SpectatorServer& spectators) {
+    // Seed is chosen here rather than inside the engine so it can be recorded
+    unsigned int seed = static_cast<unsigned int>(chrono::high_resolution_clock::now().time_since_epoch().count());
+    SnakeGameLogic game(seed);
+    GameRenderer renderer(screen, highScoreManager);
+    
+    // Board size is fixed per game; "fit" re-measures the terminal each time
+    int rows = config.rows;
+    int cols = config.cols;
+    int screenRows = 0, screenCols = 0;
+    if (screen.getSize(screenRows, screenCols)) {
+        renderer.setScreenRows(screenRows);
+        pair<int, int> fitted = renderer.fitBoard(screenRows, screenCols);
+        if (rows == 0) rows = fitted.first;
+        if (cols == 0) cols = fitted.second;
+    }
+    if (rows == 0) rows = 20;
+    if (cols == 0) cols = 40;
+    if (level) {
+        rows = level->rows;
+        cols = level->cols;
+    }
+    const CellType* layout = level ? level->cells : nullptr;
     
+    game.setIncrementalPublishing(true);
     game.initializeBoard(
         rows, 
         cols, 
-        startingLength, 
-        pointsPerFood,
-        SnakeGameLogic::getDirectionRight()
+        config.startingLength, 
+        config.pointsPerFood,
+        SnakeGameLogic::getDirectionRight(),
+        layout
     );
     
-    InputHandler input(terminal, game);
+    ReplayRecorder recorder;
+    recorder.begin(seed, rows, cols, config.startingLength, config.pointsPerFood, SnakeGameLogic::getDirectionRight(),
+                   layout);
+    
+    InputHandler input(terminal, game, mode == PLAYER_MODE);
+    Autopilot pilot;
+    HamiltonianPolicy cycle;
+    bool autopilot = mode != PLAYER_MODE;
+    
+    // Spectators see the new board while the player reads the instructions
+    if (spectators.isRunning()) {
+        spectators.broadcast(*game.getGameState());
+    }
     
     // Draw initial screen with instructions
     renderer.drawFullScreen(game, true);
     
-    // Wait for any key to start
-    bool keyPressed = false;
+    // Wait for any key to start (the demo starts by itself)
+    bool keyPressed = autopilot;
     while (!keyPressed) {
         if (terminal.kbhit()) {
             terminal.getch();
@@ -509,32 +804,86 @@ bool runGame(TerminalController& terminal, HighScoreManager& highScoreManager) {
     // LINUX FIX: Small delay after redraw to ensure terminal is ready
     this_thread::sleep_for(chrono::milliseconds(50));
     
-    // Game loop
-    auto lastUpdate = chrono::steady_clock::now();
+    // Game loop; directions arrive from the input thread, or in the demo
+    // modes only from the policy on this thread
+    FixedStepScheduler scheduler(config.tickInterval(0), 
+                                 chrono::microseconds(1000000 / config.renderRate));
+    int foodsEaten = 0;
+    uint32_t ticksPlayed = 0;
     bool gameActive = true;
+    input.start();
+    auto startTime = chrono::steady_clock::now();
+    scheduler.start(startTime);
     
     while (gameActive) {
-        auto now = chrono::steady_clock::now();
-        auto elapsed = chrono::duration_cast<chrono::milliseconds>(now - lastUpdate).count();
-        
-        // Poll input
-        char key = input.pollInput();
-        if (key == 'Q') {
+        if (input.quitRequested()) {
             return false; // User wants to quit
         }
         
-        // Update game at fixed interval
-        if (elapsed >= updateDelay) {
+#ifdef SNAKE_PROFILE
+        // Written to a file so the report does not disturb the board
+        if (input.takeProfileDumpRequest()) {
+            ofstream report("latency_profile.txt");
+            LatencyProfiler::dump(report);
+        }
+#endif
+        
+        auto now = chrono::steady_clock::now();
+        int ticks = scheduler.ticksDue(now);
+        for (int i = 0; i < ticks && gameActive; i++) {
+            if (mode == AUTOPILOT_MODE) {
+                pilot.steer(game);
+            } else if (mode == CYCLE_MODE) {
+                cycle.steer(game);
+            }
             gameActive = game.update();
+            ticksPlayed++;
+            recorder.recordTick(game);
+            if (spectators.isRunning()) {
+                spectators.broadcast(*game.getGameState());
+            }
+            renderer.collectChanges(game);
+            
+            // Speed up as food is eaten (score counts foods at pointsPerFood each)
+            int eaten = config.pointsPerFood > 0 ? game.getLiveScore() / config.pointsPerFood
+                                                 : max(0, static_cast<int>(game.getSnake().getLength()) - config.startingLength);
+            if (eaten != foodsEaten) {
+                foodsEaten = eaten;
+                scheduler.setTickInterval(config.tickInterval(foodsEaten));
+            }
+        }
+        
+        // Always draw the final state before the game over screen
+        if (scheduler.renderDue(now) || !gameActive) {
             renderer.updateGameBoard(game);
-            lastUpdate = now;
         }
         
-        this_thread::sleep_for(chrono::milliseconds(10));
+        if (gameActive) {
+            this_thread::sleep_until(scheduler.nextDeadline());
+        }
+    }
+    
+    // Hand the keyboard back to the menu loops below
+    input.stop();
+    
+    if (!config.recordPath.empty()) {
+        recorder.finish(game);
+        recorder.getReplay().save(config.recordPath);
     }
     
     // Game over - show the game over screen
-    renderer.showGameOver(game);
+    GameRecord record;
+    record.timestamp = static_cast<uint64_t>(chrono::duration_cast<chrono::milliseconds>(
+        chrono::system_clock::now().time_since_epoch()).count());
+    record.seed = seed;
+    record.score = game.getLiveScore();
+    record.length = static_cast<uint32_t>(game.getSnake().getLength());
+    record.durationMs = static_cast<uint32_t>(chrono::duration_cast<chrono::milliseconds>(
+        chrono::steady_clock::now() - startTime).count());
+    record.ticks = ticksPlayed;
+    record.mode = static_cast<uint8_t>(mode);
+    bool newHighScore = highScoreManager.recordGame(record);
+    renderer.showGameOver(game, newHighScore);
     
     // Wait for user input (R to replay, Q to quit)
     while (true) {
@@ -554,16 +903,54 @@ bool runGame(TerminalController& terminal, HighScoreManager& highScoreManager) {
 // Main
 // ============================================
 
-int main() {
+int main(int argc, char** argv) {
+    GameConfig config;
+    string error;
+    if (!config.parseArgs(argc, argv, error)) {
+        cerr << error << "\n";
+        printUsage(argv[0]);
+        return 1;
+    }
+    
+    // Mapped once; every game starts from the same read-only cells
+    LevelPack levels;
+    const LevelView* level = nullptr;
+    LevelView levelView;
+    if (!config.levelPath.empty()) {
+        if (!levels.open(config.levelPath, error)) {
+            cerr << error << "\n";
+            return 1;
+        }
+        if (static_cast<size_t>(config.levelIndex) >= levels.getLevelCount()) {
+            cerr << config.levelPath << " has " << levels.getLevelCount() << " level(s)\n";
+            return 1;
+        }
+        levelView = levels.getLevel(config.levelIndex);
+        level = &levelView;
+    }
+    
+    // Outlives the games, so spectators stay connected from one to the next
+    SpectatorServer spectators;
+    if (config.servePort != 0 && !spectators.start(static_cast<uint16_t>(config.servePort), error)) {
+        cerr << error << "\n";
+        return 1;
+    }
+    
+    ConsoleScreen screen;
+    if (!screen.open()) {
+        cerr << "No console to draw on\n";
+        return 1;
+    }
     TerminalController terminal;
     HighScoreManager highScoreManager;
     terminal.enableRawMode();
     
     while (true) {
-        showIntro(terminal, highScoreManager);
+        showIntro(screen, highScoreManager);
         
         // Wait for ENTER or Q
         bool startGame = false;
+        PlayMode mode = PLAYER_MODE;
         bool quit = false;
         
         while (!startGame && !quit) {
@@ -571,6 +958,12 @@ int main() {
                 char key = terminal.getch();
                 if (key == '\n' || key == '\r' || key == ' ') {
                     startGame = true;
+                } else if (key == 'a' || key == 'A') {
+                    startGame = true;
+                    mode = AUTOPILOT_MODE;
+                } else if (key == 'h' || key == 'H') {
+                    startGame = true;
+                    mode = CYCLE_MODE;
                 } else if (key == 'q' || key == 'Q') {
                     quit = true;
                 }
@@ -583,19 +976,24 @@ int main() {
         }
         
         if (startGame) {
-            bool replay = runGame(terminal, highScoreManager);
+            bool replay = runGame(terminal, screen, highScoreManager, config, mode, level, spectators);
             if (!replay) {
                 break; // User chose to quit after game over
             }
         }
     }
     
-    terminal.clearScreen();
-    terminal.showCursor();
+    // Hands the shell its screen back (Windows) before the goodbye
+    screen.clear();
+    screen.present();
+    screen.close();
     // LINUX FIX: Build exit message in buffer
     ostringstream exitBuffer;
     exitBuffer << "\n  Thanks for playing!\n\n";
     cout << exitBuffer.str();
+#ifdef SNAKE_PROFILE
+    LatencyProfiler::dump(cout);
+#endif
     cout.flush();
     
     return 0;
@@ -0,0 +1,321 @@
+// multiSnake.h
+#ifndef MULTISNAKE_H
+#define MULTISNAKE_H
+
+#include "gameLogic.h"
+
+// ============================================================================
+// MULTIPLAYER GAME
+// ============================================================================
+
+/**
+ * @brief Where one snake starts: head position and direction of travel
+ *        (the body trails behind it, as in Snake::initialize).
+ */
+struct SnakeSpawn {
+    pair<int, int> head;
+    Direction direction;
+};
+
+/**
+ * @brief Several snakes (players, bots, remote clients) on one Board.
+ *
+ * Every snake moves once per update() and all moves are simultaneous.
+ * Each snake gets the single-player checks in the same order
+ * (CollisionDetector::isOutOfBounds, isWall, then body), except that the
+ * body check covers every snake: a SNAKE cell is solid unless it is a
+ * tail that leaves on this tick (its owner has no pending growth and does
+ * not eat this tick). Heads that survive those checks and land on the same
+ * cell all die (head-on).
+ *
+ * Both rules go through one small open-addressing hash keyed by cell,
+ * rebuilt every tick from the leaving tails and the new heads, so a tick
+ * costs O(N) for N snakes instead of comparing every pair of heads. Slots
+ * carry a stamp, so rebuilding never clears the table.
+ *
+ * Dead snakes are taken off the board at the end of their tick (their
+ * cells become empty, food is never dropped) and their score stays. The
+ * game is over when no snake is alive, or when the board is full. One
+ * food is on the board at a time, placed like SnakeGameLogic with the same
+ * GameRng, so a one-snake game matches SnakeGameLogic tick for tick.
+ *
+ * Logic-thread only, except setDirection(): each snake's input queue is a
+ * DirectionController ring, so one producer thread per snake may steer it.
+ */
+class MultiSnakeGame {
+private:
+    static constexpr uint32_t NO_CELL = UINT32_MAX;
+
+    /**
+     * @brief One hash slot: a cell touched by this tick's moves.
+     */
+    struct CellSlot {
+        uint32_t stamp;              ///< Slot is live when equal to the tick stamp
+        uint32_t cell;               ///< Flat board index
+        bool leavingTail;            ///< A tail moves off this cell this tick
+        uint32_t heads;              ///< Surviving heads moving onto this cell
+    };
+
+    Board board;
+    GameRng rng;
+    FoodManager foodManager;
+    vector<Snake> snakes;
+    unique_ptr<DirectionController[]> controllers;   ///< Not movable (atomics), hence an array
+    vector<int> scores;
+    vector<uint8_t> alive;
+    vector<uint32_t> nextHead;       ///< Target cell of each snake this tick, NO_CELL if dead
+    vector<CellSlot> slots;          ///< Power-of-two sized, at least 4 per snake
+    uint32_t slotShift = 32;
+    uint32_t stamp = 0;
+    size_t aliveCount = 0;
+    int pointsPerFood = 10;
+    bool gameOver = true;
+
+    /**
+     * @brief Finds or claims the hash slot of a cell for this tick.
+     * @param cell Flat board index
+     * @return Slot for the cell (zeroed when newly claimed)
+     */
+    CellSlot& slotFor(uint32_t cell) {
+        size_t mask = slots.size() - 1;
+        size_t i = (cell * 2654435769u) >> slotShift;
+        while (slots[i].stamp == stamp && slots[i].cell != cell) {
+            i = (i + 1) & mask;
+        }
+        if (slots[i].stamp != stamp) {
+            slots[i] = {stamp, cell, false, 0};
+        }
+        return slots[i];
+    }
+
+    /**
+     * @brief Looks up a cell without claiming a slot.
+     * @param cell Flat board index
+     * @return Slot for the cell, or nullptr if this tick has not touched it
+     */
+    const CellSlot* findSlot(uint32_t cell) const {
+        size_t mask = slots.size() - 1;
+        for (size_t i = (cell * 2654435769u) >> slotShift; slots[i].stamp == stamp; i = (i + 1) & mask) {
+            if (slots[i].cell == cell) return &slots[i];
+        }
+        return nullptr;
+    }
+
+    void nextStamp() {
+        if (++stamp == 0) {
+            for (CellSlot& slot : slots) slot.stamp = 0;
+            stamp = 1;
+        }
+    }
+
+    /**
+     * @brief Takes a dead snake's body off the board.
+     * @param id Snake index
+     */
+    void removeBody(size_t id) {
+        auto [first, second] = snakes[id].getBodySpans();
+        for (uint32_t index : first) board.setCell(index, EMPTY);
+        for (uint32_t index : second) board.setCell(index, EMPTY);
+    }
+
+public:
+    MultiSnakeGame() : foodManager(rng) {
+        auto seed = chrono::high_resolution_clock::now().time_since_epoch().count();
+        rng.seed(static_cast<unsigned int>(seed));
+    }
+
+    /**
+     * @brief Constructs a game with a fixed RNG seed for reproducible runs.
+     * @param seed Seed for food placement
+     */
+    explicit MultiSnakeGame(unsigned int seed) : foodManager(rng) {
+        rng.seed(seed);
+    }
+
+    /**
+     * @brief Spreads snakes over the board in spawn order.
+     *
+     * Snakes start on evenly spaced rows, heading RIGHT from the left part
+     * of the row and LEFT from the right part on alternate rows, the first
+     * one on the centre row like SnakeGameLogic.
+     * @param rows Number of board rows
+     * @param cols Number of board columns
+     * @param count Number of snakes
+     * @return One spawn per snake
+     */
+    static vector<SnakeSpawn> spreadSpawns(int rows, int cols, size_t count) {
+        vector<SnakeSpawn> spawns;
+        spawns.reserve(count);
+        int spacing = max(1, rows / static_cast<int>(max<size_t>(count, 1)));
+        for (size_t i = 0; i < count; i++) {
+            int row = (rows / 2 + static_cast<int>(i) * spacing) % rows;
+            bool right = i % 2 == 0;
+            spawns.push_back({{row, right ? cols / 2 : cols - 1 - cols / 4}, right ? RIGHT : LEFT});
+        }
+        return spawns;
+    }
+
+    /**
+     * @brief Starts a game with one snake per spawn.
+     *
+     * Snakes are laid in spawn order and stop at walls and earlier snakes;
+     * a snake whose head cell is already taken starts dead.
+     * @param rows Number of board rows
+     * @param cols Number of board columns
+     * @param startingLength Initial length of every snake
+     * @param pointsPerFood Points awarded per food
+     * @param spawns Start of each snake
+     * @param layout Optional wall layout of rows * cols cells (see Board::initialize)
+     */
+    void initializeBoard(int rows, int cols, int startingLength, int pointsPerFood,
+                         span<const SnakeSpawn> spawns, const CellType* layout = nullptr) {
+        this->pointsPerFood = pointsPerFood;
+        board.initialize(rows, cols, layout);
+
+        size_t count = spawns.size();
+        if (snakes.size() != count) {
+            snakes.resize(count);
+            controllers = make_unique<DirectionController[]>(count);
+            size_t capacity = 4;
+            slotShift = 30;
+            while (capacity < 4 * count) {
+                capacity *= 2;
+                slotShift--;
+            }
+            slots.assign(capacity, {0, 0, false, 0});
+            stamp = 0;
+        }
+        scores.assign(count, 0);
+        alive.assign(count, 0);
+        nextHead.assign(count, NO_CELL);
+        aliveCount = 0;
+
+        for (size_t i = 0; i < count; i++) {
+            controllers[i].initialize(spawns[i].direction);
+            snakes[i].initialize(spawns[i].head, startingLength, spawns[i].direction, board);
+            alive[i] = snakes[i].getLength() > 0;
+            aliveCount += alive[i];
+        }
+
+        foodManager.placeRandom(board);
+        gameOver = aliveCount == 0;
+    }
+
+    /**
+     * @brief Queues a direction change for one snake (thread-safe, one producer per snake).
+     * @param id Snake index
+     * @param dir Direction to move
+     */
+    void setDirection(size_t id, Direction dir) {
+        controllers[id].setInput(dir);
+    }
+
+    /**
+     * @brief Moves every live snake by one tick.
+     * @return True if the game continues, false once it is over
+     */
+    bool update() {
+        PROFILE_SCOPE(PROBE_UPDATE);
+        if (gameOver) {
+            return false;
+        }
+        nextStamp();
+        size_t count = snakes.size();
+
+        // Tails that will vacate, so heads may follow any snake's tail
+        for (size_t i = 0; i < count; i++) {
+            if (alive[i] && !snakes[i].hasPendingGrowth()) {
+                slotFor(snakes[i].getSegmentIndex(snakes[i].getLength() - 1)).leavingTail = true;
+            }
+        }
+
+        uint32_t foodCell = NO_CELL;
+        if (foodManager.isPresent()) {
+            pair<int, int> food = foodManager.getPosition();
+            foodCell = static_cast<uint32_t>(board.toIndex(food.first, food.second));
+        }
+        size_t eater = SIZE_MAX;
+
+        // Per-snake checks, in the single-player order
+        for (size_t i = 0; i < count; i++) {
+            nextHead[i] = NO_CELL;
+            if (!alive[i]) continue;
+            controllers[i].processInput();
+            pair<int, int> newHead = controllers[i].getNextPosition(snakes[i].getHead());
+            if (CollisionDetector::isOutOfBounds(newHead, board)) continue;
+            if (CollisionDetector::isWall(newHead, board)) continue;
+
+            uint32_t cell = static_cast<uint32_t>(board.toIndex(newHead.first, newHead.second));
+            if (board.getCell(cell) == SNAKE) {
+                const CellSlot* slot = findSlot(cell);
+                if (!slot || !slot->leavingTail) continue;
+            }
+            nextHead[i] = cell;
+            slotFor(cell).heads++;
+            if (cell == foodCell) eater = i;
+        }
+
+        // A snake that eats keeps its tail, so a head following it dies
+        uint32_t keptTail = NO_CELL;
+        if (eater != SIZE_MAX && findSlot(foodCell)->heads == 1 && !snakes[eater].hasPendingGrowth()) {
+            keptTail = snakes[eater].getSegmentIndex(snakes[eater].getLength() - 1);
+        }
+
+        // Head-on: every head sharing a cell dies; then clear the dead
+        for (size_t i = 0; i < count; i++) {
+            if (nextHead[i] != NO_CELL && (findSlot(nextHead[i])->heads > 1 || nextHead[i] == keptTail)) {
+                nextHead[i] = NO_CELL;
+            }
+            if (alive[i] && nextHead[i] == NO_CELL) {
+                alive[i] = false;
+                aliveCount--;
+                removeBody(i);
+            }
+        }
+
+        // Survivors eat, then all tails leave before any head claims a
+        // cell, so a head may take the cell another tail just left
+        for (size_t i = 0; i < count; i++) {
+            if (nextHead[i] == NO_CELL) continue;
+            if (CollisionDetector::isFood(board.toPosition(nextHead[i]), foodManager)) {
+                snakes[i].grow();
+                scores[i] += pointsPerFood;
+                foodManager.remove(board);
+            }
+            snakes[i].vacateTail(board);
+        }
+        bool growing = false;
+        for (size_t i = 0; i < count; i++) {
+            if (nextHead[i] == NO_CELL) continue;
+            snakes[i].advanceHead(nextHead[i], board);
+            growing = growing || snakes[i].hasPendingGrowth();
+        }
+
+        if (!foodManager.isPresent()) {
+            foodManager.placeRandom(board);
+        }
+
+        // Over when nobody is left, or the board is full (win)
+        if (aliveCount == 0 || (!foodManager.isPresent() && !growing)) {
+            gameOver = true;
+            return false;
+        }
+        return true;
+    }
+
+    // ========================================================================
+    // LOGIC-THREAD ACCESSORS (live state, not synchronized)
+    // ========================================================================
+
+    const Board& getBoard() const { return board; }
+    const FoodManager& getFoodManager() const { return foodManager; }
+    size_t getSnakeCount() const { return snakes.size(); }
+    size_t getAliveCount() const { return aliveCount; }
+    const Snake& getSnake(size_t id) const { return snakes[id]; }
+    bool isAlive(size_t id) const { return alive[id]; }
+    int getScore(size_t id) const { return scores[id]; }
+    Direction getCurrentDirection(size_t id) const { return controllers[id].getCurrent(); }
+    bool isGameOver() const { return gameOver; }
+};
+
+#endif // MULTISNAKE_H
@@ -0,0 +1,218 @@
+// parallelRunner.h
+#ifndef PARALLELRUNNER_H
+#define PARALLELRUNNER_H
+
+#include "headlessRunner.h"
+#include <thread>
+
+// ============================================================================
+// RESULT DISTRIBUTIONS
+// ============================================================================
+
+/**
+ * @brief Score and game-length distributions for a set of games.
+ * 
+ * Plain counters so each worker fills its own copy and the copies are
+ * merged by addition once the workers have finished.
+ */
+struct GameDistribution {
+    static constexpr size_t TICK_BUCKETS = 64;
+
+    vector<uint64_t> foodCounts;     ///< foodCounts[n] = games that ate n food
+    array<uint64_t, TICK_BUCKETS> tickBuckets{}; ///< Bucket b holds games of [2^b, 2^(b+1)) ticks
+    int pointsPerFood = 10;
+
+    void initialize(const SimulationConfig& config) {
+        pointsPerFood = config.pointsPerFood > 0 ? config.pointsPerFood : 1;
+        foodCounts.assign(static_cast<size_t>(config.rows) * config.cols + 1, 0);
+        tickBuckets.fill(0);
+    }
+
+    void add(const SimulationResult& result) {
+        size_t eaten = min(static_cast<size_t>(result.score / pointsPerFood), foodCounts.size() - 1);
+        foodCounts[eaten]++;
+        
+        size_t bucket = 0;
+        for (uint64_t ticks = result.ticks; ticks > 1 && bucket + 1 < TICK_BUCKETS; ticks >>= 1) {
+            bucket++;
+        }
+        tickBuckets[bucket]++;
+    }
+
+    void merge(const GameDistribution& other) {
+        for (size_t i = 0; i < foodCounts.size() && i < other.foodCounts.size(); i++) {
+            foodCounts[i] += other.foodCounts[i];
+        }
+        for (size_t i = 0; i < TICK_BUCKETS; i++) {
+            tickBuckets[i] += other.tickBuckets[i];
+        }
+    }
+
+    /**
+     * @brief Gets the score at a percentile of the score distribution.
+     * @param percentile Value in [0, 100]
+     * @return Smallest score with at least that share of games at or below it
+     */
+    int scorePercentile(double percentile) const {
+        uint64_t total = 0;
+        for (uint64_t count : foodCounts) total += count;
+        if (total == 0) return 0;
+        
+        uint64_t threshold = static_cast<uint64_t>(percentile / 100.0 * total + 0.5);
+        uint64_t seen = 0;
+        for (size_t i = 0; i < foodCounts.size(); i++) {
+            seen += foodCounts[i];
+            if (seen >= threshold && seen > 0) return static_cast<int>(i) * pointsPerFood;
+        }
+        return static_cast<int>(foodCounts.size() - 1) * pointsPerFood;
+    }
+};
+
+// ============================================================================
+// PARALLEL RUNNER
+// ============================================================================
+
+/**
+ * @brief Aggregated results of a parallel batch.
+ */
+struct ParallelStats {
+    BatchStats totals;
+    GameDistribution distribution;
+    unsigned int threads = 0;
+    uint64_t steals = 0;             ///< Seed ranges taken from another worker
+};
+
+/**
+ * @brief Runs independent headless games across all cores.
+ * 
+ * Each worker owns a HeadlessRunner, so its Board and Snake storage is
+ * allocated once and reused for every game it plays. Seeds are split into
+ * one contiguous range per worker; a worker pops seeds from the front of
+ * its own range and, when empty, steals the back half of another worker's
+ * range. A range is a single 64-bit atomic (begin, end) pair updated by
+ * CAS, so scheduling is lock-free. Results stay in per-worker statistics
+ * and are merged after the workers join, so no lock is ever shared.
+ */
+class ParallelRunner {
+private:
+    struct alignas(64) Worker {
+        atomic<uint64_t> range{0};   ///< (begin << 32) | end, seed offsets
+        BatchStats stats;
+        GameDistribution distribution;
+        uint64_t steals = 0;
+    };
+
+    static uint64_t packRange(uint32_t begin, uint32_t end) {
+        return (static_cast<uint64_t>(begin) << 32) | end;
+    }
+
+    static uint32_t rangeBegin(uint64_t range) { return static_cast<uint32_t>(range >> 32); }
+    static uint32_t rangeEnd(uint64_t range) { return static_cast<uint32_t>(range); }
+
+    SimulationConfig config;
+    unsigned int threadCount;
+
+    // Takes the next offset from the front of a worker's own range
+    static bool popOwn(Worker& worker, uint32_t& offset) {
+        uint64_t range = worker.range.load(memory_order_acquire);
+        while (rangeBegin(range) < rangeEnd(range)) {
+            uint64_t next = packRange(rangeBegin(range) + 1, rangeEnd(range));
+            if (worker.range.compare_exchange_weak(range, next, memory_order_acq_rel)) {
+                offset = rangeBegin(range);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Moves the back half of a victim's range into the thief's (empty) range
+    static bool steal(Worker& victim, Worker& thief) {
+        uint64_t range = victim.range.load(memory_order_acquire);
+        while (rangeBegin(range) < rangeEnd(range)) {
+            uint32_t begin = rangeBegin(range);
+            uint32_t end = rangeEnd(range);
+            uint32_t middle = begin + (end - begin) / 2;
+            if (victim.range.compare_exchange_weak(range, packRange(begin, middle), memory_order_acq_rel)) {
+                thief.range.store(packRange(middle, end), memory_order_release);
+                return true;
+            }
+        }
+        return false;
+    }
+
+public:
+    /**
+     * @brief Constructs a runner.
+     * @param config Game parameters shared by all games
+     * @param threads Worker count; 0 uses hardware_concurrency()
+     */
+    ParallelRunner(const SimulationConfig& config, unsigned int threads = 0) 
+        : config(config), threadCount(threads) {
+        if (threadCount == 0) threadCount = max(1u, thread::hardware_concurrency());
+    }
+
+    /**
+     * @brief Plays games for seeds [firstSeed, firstSeed + gameCount).
+     * @param firstSeed Seed of the first game
+     * @param gameCount Number of games (at most 2^32 - 1)
+     * @param makePolicy Callable `Policy(unsigned int worker)` building each worker's policy
+     * @return Merged statistics and distributions
+     */
+    template <typename PolicyFactory>
+    ParallelStats run(unsigned int firstSeed, uint32_t gameCount, PolicyFactory&& makePolicy) {
+        unsigned int workersUsed = static_cast<unsigned int>(
+            min<uint64_t>(threadCount, max<uint32_t>(gameCount, 1)));
+        vector<Worker> workers(workersUsed);
+        for (unsigned int w = 0; w < workersUsed; w++) {
+            uint32_t begin = static_cast<uint32_t>(static_cast<uint64_t>(gameCount) * w / workersUsed);
+            uint32_t end = static_cast<uint32_t>(static_cast<uint64_t>(gameCount) * (w + 1) / workersUsed);
+            workers[w].range.store(packRange(begin, end), memory_order_relaxed);
+            workers[w].distribution.initialize(config);
+        }
+        
+        auto start = chrono::steady_clock::now();
+        auto workerLoop = [&](unsigned int self) {
+            Worker& worker = workers[self];
+            HeadlessRunner runner(config);
+            auto policy = makePolicy(self);
+            
+            while (true) {
+                uint32_t offset;
+                if (popOwn(worker, offset)) {
+                    SimulationResult result = runner.runGame(firstSeed + offset, policy);
+                    worker.stats.add(result);
+                    worker.distribution.add(result);
+                    continue;
+                }
+                
+                bool stole = false;
+                for (unsigned int i = 1; i < workersUsed && !stole; i++) {
+                    stole = steal(workers[(self + i) % workersUsed], worker);
+                }
+                if (!stole) break;
+                worker.steals++;
+            }
+        };
+        
+        vector<thread> threads;
+        threads.reserve(workersUsed > 0 ? workersUsed - 1 : 0);
+        for (unsigned int w = 1; w < workersUsed; w++) {
+            threads.emplace_back(workerLoop, w);
+        }
+        workerLoop(0);
+        for (thread& t : threads) t.join();
+        
+        ParallelStats merged;
+        merged.threads = workersUsed;
+        merged.distribution.initialize(config);
+        for (const Worker& worker : workers) {
+            merged.totals.merge(worker.stats);
+            merged.distribution.merge(worker.distribution);
+            merged.steals += worker.steals;
+        }
+        merged.totals.elapsedSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        return merged;
+    }
+};
+
+#endif // PARALLELRUNNER_H
@@ -0,0 +1,400 @@
+// replay.h
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "gameLogic.h"
+#include <fstream>
+#include <string>
+
+// ============================================================================
+// INPUT LOG
+// ============================================================================
+
+/**
+ * @brief Run-length encoded log of the direction applied on every tick.
+ *
+ * Each tick is a 2-bit direction. Consecutive equal directions collapse
+ * into runs stored one per byte: the direction in the top two bits and the
+ * run length minus one in the low six, so a straight stretch of up to 64
+ * ticks costs one byte. Longer stretches continue in the next byte.
+ *
+ * Logging the applied direction rather than raw key presses makes playback
+ * independent of input timing: feeding it back through setDirection() one
+ * tick at a time reproduces every turn exactly. Games must start moving
+ * (initial direction other than NONE), which every caller here does.
+ */
+class InputLog {
+private:
+    static constexpr uint8_t RUN_MASK = 0x3F;
+
+    vector<uint8_t> runs;
+    uint64_t tickCount = 0;
+
+public:
+    /**
+     * @brief Read position inside the log; cheap to copy for checkpoints.
+     */
+    class Cursor {
+    private:
+        const InputLog* log;
+        size_t run;
+        uint32_t offset;
+
+    public:
+        explicit Cursor(const InputLog* log = nullptr) : log(log), run(0), offset(0) {}
+
+        /**
+         * @brief Returns the next tick's direction and advances.
+         * @return Direction applied on that tick (the log must not be exhausted)
+         */
+        Direction next() {
+            uint8_t code = log->runs[run];
+            if (offset < (code & RUN_MASK)) {
+                offset++;
+            } else {
+                run++;
+                offset = 0;
+            }
+            return static_cast<Direction>(code >> 6);
+        }
+    };
+
+    void clear() {
+        runs.clear();
+        tickCount = 0;
+    }
+
+    /**
+     * @brief Appends one tick.
+     * @param dir Direction applied on the tick (UP, DOWN, LEFT or RIGHT)
+     */
+    void append(Direction dir) {
+        uint8_t code = static_cast<uint8_t>((dir & 3) << 6);
+        if (!runs.empty() && (runs.back() & ~RUN_MASK) == code && (runs.back() & RUN_MASK) < RUN_MASK) {
+            runs.back()++;
+        } else {
+            runs.push_back(code);
+        }
+        tickCount++;
+    }
+
+    Cursor begin() const { return Cursor(this); }
+    uint64_t getTickCount() const { return tickCount; }
+    const vector<uint8_t>& getRuns() const { return runs; }
+
+    /**
+     * @brief Replaces the log with previously encoded runs.
+     * @param encoded Run bytes as returned by getRuns()
+     */
+    void assign(vector<uint8_t> encoded) {
+        runs = move(encoded);
+        tickCount = 0;
+        for (uint8_t code : runs) {
+            tickCount += (code & RUN_MASK) + 1;
+        }
+    }
+};
+
+// ============================================================================
+// REPLAY
+// ============================================================================
+
+/**
+ * @brief Everything needed to reconstruct a game: its settings, seed and inputs.
+ *
+ * Saved as a small little-endian binary file (magic "SNKR"). Games on a
+ * level carry its wall cells, so a replay never depends on the level file.
+ */
+struct Replay {
+    unsigned int seed = 0;
+    int rows = 0;
+    int cols = 0;
+    int startingLength = 0;
+    int pointsPerFood = 0;
+    Direction initialDirection = RIGHT;
+    int finalScore = 0;              ///< Score when recording stopped, for verification
+    InputLog inputs;
+    vector<uint32_t> walls;          ///< Flat indices of wall cells, ascending
+
+    /**
+     * @brief Writes the replay to a file.
+     * @param path Destination path (overwritten)
+     * @return True on success
+     */
+    bool save(const string& path) const {
+        ofstream file(path, ios::binary);
+        if (!file) return false;
+
+        const vector<uint8_t>& runs = inputs.getRuns();
+        file.write("SNKR", 4);
+        writeValue(file, FORMAT_VERSION);
+        writeValue(file, seed);
+        writeValue(file, static_cast<uint32_t>(rows));
+        writeValue(file, static_cast<uint32_t>(cols));
+        writeValue(file, static_cast<uint32_t>(startingLength));
+        writeValue(file, static_cast<uint32_t>(pointsPerFood));
+        writeValue(file, static_cast<uint32_t>(initialDirection));
+        writeValue(file, static_cast<uint32_t>(finalScore));
+        writeValue(file, static_cast<uint32_t>(runs.size()));
+        file.write(reinterpret_cast<const char*>(runs.data()), static_cast<streamsize>(runs.size()));
+        writeValue(file, static_cast<uint32_t>(walls.size()));
+        for (uint32_t wall : walls) {
+            writeValue(file, wall);
+        }
+        return static_cast<bool>(file);
+    }
+
+    /**
+     * @brief Reads a replay written by save().
+     * @param path Source path
+     * @return True on success; the replay is unchanged on failure
+     */
+    bool load(const string& path) {
+        ifstream file(path, ios::binary);
+        char magic[4];
+        uint32_t version, fields[8];
+        if (!file.read(magic, 4) || memcmp(magic, "SNKR", 4) != 0) return false;
+        if (!readValue(file, version) || version != FORMAT_VERSION) return false;
+        for (uint32_t& field : fields) {
+            if (!readValue(file, field)) return false;
+        }
+        if (fields[5] > RIGHT || !validSettings(fields[1], fields[2], fields[3], static_cast<Direction>(fields[5]))) {
+            return false;
+        }
+
+        // The run count is untrusted: check the file holds that many bytes
+        // before allocating for them
+        streampos start = file.tellg();
+        if (!file.seekg(0, ios::end)) return false;
+        streamoff remaining = file.tellg() - start;
+        if (!file.seekg(start) || remaining < static_cast<streamoff>(fields[7])) return false;
+        vector<uint8_t> runs(fields[7]);
+        if (!file.read(reinterpret_cast<char*>(runs.data()), static_cast<streamsize>(runs.size()))) return false;
+        
+        vector<uint32_t> wallCells;
+        uint32_t wallCount = 0;
+        if (!readValue(file, wallCount)) return false;
+        uint64_t cellCount = static_cast<uint64_t>(fields[1]) * fields[2];
+        if (wallCount > cellCount) return false;
+        wallCells.resize(wallCount);
+        uint32_t centre = fields[1] / 2 * fields[2] + fields[2] / 2;
+        for (uint32_t& wall : wallCells) {
+            if (!readValue(file, wall) || wall >= cellCount || wall == centre) return false;
+        }
+
+        seed = fields[0];
+        rows = static_cast<int>(fields[1]);
+        cols = static_cast<int>(fields[2]);
+        startingLength = static_cast<int>(fields[3]);
+        pointsPerFood = static_cast<int>(fields[4]);
+        initialDirection = static_cast<Direction>(fields[5]);
+        finalScore = static_cast<int>(fields[6]);
+        inputs.assign(move(runs));
+        walls = move(wallCells);
+        return true;
+    }
+
+private:
+    /// Largest board a replay may describe (4096 x 4096 cells)
+    static constexpr uint64_t MAX_CELLS = uint64_t(1) << 24;
+
+    /**
+     * @brief Checks a loaded board size and snake fit initializeBoard().
+     * @param rows Board rows
+     * @param cols Board columns
+     * @param length Starting length, which must fit between the centre
+     *        cell and the edge behind it
+     * @param direction Initial direction (UP, DOWN, LEFT or RIGHT)
+     * @return True if a game can start with these settings
+     */
+    static bool validSettings(uint32_t rows, uint32_t cols, uint32_t length, Direction direction) {
+        if (rows == 0 || cols == 0 || static_cast<uint64_t>(rows) * cols > MAX_CELLS) return false;
+        uint32_t room = direction == RIGHT ? cols / 2 + 1 : direction == LEFT ? cols - cols / 2
+                      : direction == DOWN ? rows / 2 + 1 : rows - rows / 2;
+        return length > 0 && length <= room;
+    }
+
+    /// Bumped whenever the same seed and inputs would play out differently
+    /// (2: food is the k-th empty cell in row-major order; 4: counter-based
+    /// GameRng) or the layout grows (3: wall list after the inputs). Older
+    /// files would not replay the same game, so only this version loads
+    static constexpr uint32_t FORMAT_VERSION = 4;
+
+    static void writeValue(ofstream& file, uint32_t value) {
+        unsigned char bytes[4] = {
+            static_cast<unsigned char>(value), static_cast<unsigned char>(value >> 8),
+            static_cast<unsigned char>(value >> 16), static_cast<unsigned char>(value >> 24)};
+        file.write(reinterpret_cast<const char*>(bytes), 4);
+    }
+
+    static bool readValue(ifstream& file, uint32_t& value) {
+        unsigned char bytes[4];
+        if (!file.read(reinterpret_cast<char*>(bytes), 4)) return false;
+        value = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+        return true;
+    }
+};
+
+/**
+ * @brief Captures a game into a Replay as it is played.
+ *
+ * Call begin() with the settings passed to initializeBoard(), recordTick()
+ * after every update(), and finish() once the game ends.
+ */
+class ReplayRecorder {
+private:
+    Replay replay;
+
+public:
+    void begin(unsigned int seed, int rows, int cols, int startingLength,
+               int pointsPerFood, Direction initialDirection, const CellType* layout = nullptr) {
+        replay.seed = seed;
+        replay.rows = rows;
+        replay.cols = cols;
+        replay.startingLength = startingLength;
+        replay.pointsPerFood = pointsPerFood;
+        replay.initialDirection = initialDirection;
+        replay.finalScore = 0;
+        replay.inputs.clear();
+        replay.walls.clear();
+        if (layout) {
+            size_t cellCount = static_cast<size_t>(rows) * cols;
+            for (size_t i = 0; i < cellCount; i++) {
+                if (layout[i] == WALL) replay.walls.push_back(static_cast<uint32_t>(i));
+            }
+        }
+    }
+
+    /**
+     * @brief Logs the direction the last update() moved in.
+     * @param game Game that was just updated (logic thread)
+     */
+    void recordTick(const SnakeGameLogic& game) {
+        replay.inputs.append(game.getCurrentDirection());
+    }
+
+    void finish(const SnakeGameLogic& game) {
+        replay.finalScore = game.getLiveScore();
+    }
+
+    const Replay& getReplay() const { return replay; }
+};
+
+// ============================================================================
+// PLAYBACK
+// ============================================================================
+
+/**
+ * @brief Reconstructs a recorded game at full speed, with seeking.
+ *
+ * Publishing is disabled, so playback runs as fast as the headless runner;
+ * call getGame().publishNow() to snapshot a position for rendering.
+ *
+ * A checkpoint is saved every checkpointInterval ticks the first time
+ * playback passes it. seek() restores the nearest checkpoint at or before
+ * the target and plays forward from there, so any tick is at most one
+ * interval of simulation away once the game has been played through.
+ */
+class ReplayPlayer {
+private:
+    struct Checkpoint {
+        InputLog::Cursor cursor;
+        GameCheckpoint state;
+    };
+
+    const Replay& replay;
+    vector<CellType> layout;         ///< Walls rebuilt from the replay, empty if none
+    SnakeGameLogic game;
+    InputLog::Cursor cursor;
+    uint64_t tick = 0;
+    uint64_t checkpointInterval;
+    bool running = true;
+    vector<Checkpoint> checkpoints;  ///< checkpoints[i] is the state at tick i * interval
+
+    void saveCheckpointIfDue() {
+        if (tick % checkpointInterval != 0 || tick / checkpointInterval != checkpoints.size()) return;
+        checkpoints.push_back({cursor, {}});
+        game.saveCheckpoint(checkpoints.back().state);
+    }
+
+public:
+    /**
+     * @brief Prepares playback of a replay (which must outlive the player).
+     * @param replay Recorded game
+     * @param checkpointInterval Ticks between seek checkpoints
+     */
+    explicit ReplayPlayer(const Replay& replay, uint64_t checkpointInterval = 1024)
+        : replay(replay), game(replay.seed), checkpointInterval(max<uint64_t>(checkpointInterval, 1)) {
+        game.setPublishing(false);
+        if (!replay.walls.empty()) {
+            layout.assign(static_cast<size_t>(replay.rows) * replay.cols, EMPTY);
+            for (uint32_t wall : replay.walls) {
+                layout[wall] = WALL;
+            }
+        }
+        restart();
+    }
+
+    /**
+     * @brief Returns to tick 0.
+     */
+    void restart() {
+        game.setSeed(replay.seed);
+        game.initializeBoard(replay.rows, replay.cols, replay.startingLength,
+                             replay.pointsPerFood, replay.initialDirection,
+                             layout.empty() ? nullptr : layout.data());
+        cursor = replay.inputs.begin();
+        tick = 0;
+        running = true;
+        saveCheckpointIfDue();
+    }
+
+    /**
+     * @brief Plays one recorded tick.
+     * @return False if the recording has ended (nothing was played)
+     */
+    bool step() {
+        if (isFinished()) return false;
+        game.setDirection(cursor.next());
+        running = game.update();
+        tick++;
+        saveCheckpointIfDue();
+        return true;
+    }
+
+    /**
+     * @brief Plays the rest of the recording without stopping.
+     * @return Tick reached
+     */
+    uint64_t playToEnd() {
+        while (step()) {}
+        return tick;
+    }
+
+    /**
+     * @brief Moves playback to a tick, forwards or backwards.
+     * @param target Tick to stop at (clamped to the end of the recording)
+     */
+    void seek(uint64_t target) {
+        target = min(target, replay.inputs.getTickCount());
+        size_t nearest = min<size_t>(target / checkpointInterval, checkpoints.size() - 1);
+        uint64_t nearestTick = nearest * checkpointInterval;
+
+        // Restore unless playing forward from here is already the shorter way
+        if (target < tick || nearestTick > tick) {
+            const Checkpoint& checkpoint = checkpoints[nearest];
+            game.restoreCheckpoint(checkpoint.state);
+            cursor = checkpoint.cursor;
+            tick = nearestTick;
+            running = !game.isLiveGameOver();
+        }
+        while (tick < target && step()) {}
+    }
+
+    bool isFinished() const { return !running || tick >= replay.inputs.getTickCount(); }
+    uint64_t getTick() const { return tick; }
+    uint64_t getTickCount() const { return replay.inputs.getTickCount(); }
+    SnakeGameLogic& getGame() { return game; }
+};
+
+#endif // REPLAY_H
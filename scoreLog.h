@@ -0,0 +1,244 @@
+// scoreLog.h
+#ifndef SCORELOG_H
+#define SCORELOG_H
+
+#include "mappedFile.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+    #include <io.h>
+    #include <fcntl.h>
+    #include <sys/stat.h>
+#endif
+
+// ============================================================================
+// SCORE LOG
+// ============================================================================
+
+/**
+ * @brief One finished game as stored in the score log.
+ */
+struct GameRecord {
+    uint64_t timestamp = 0;          ///< End of the game, ms since the Unix epoch
+    uint32_t seed = 0;               ///< Seed the game was played with
+    int32_t score = 0;
+    uint32_t length = 0;             ///< Final snake length
+    uint32_t durationMs = 0;         ///< Wall-clock time from first tick to game over
+    uint32_t ticks = 0;
+    uint8_t mode = 0;                ///< 0 for a player, otherwise a demo (bot) game
+};
+
+/**
+ * @brief Append-only log of finished games with a background writer.
+ *
+ * Records are fixed-size (RECORD_SIZE bytes, little-endian, each with a
+ * magic and a checksum) and appended with O_APPEND, so several running
+ * instances can share one log without losing each other's games. append()
+ * only queues the record; a writer thread writes everything queued with
+ * one write() and then one fsync, so the UI never waits on the disk and a
+ * burst of games costs one sync. Records that were queued when the
+ * process ends are written by the destructor.
+ *
+ * load() maps the log read-only and scans it once. Torn records (a crash
+ * in the middle of a write) fail their checksum and are skipped, the scan
+ * resynchronising on the next magic.
+ */
+class ScoreLog {
+public:
+    static constexpr size_t RECORD_SIZE = 40;
+
+private:
+    static constexpr uint32_t MAGIC = 0x52434E53;   ///< "SNCR"
+    static constexpr uint8_t VERSION = 1;
+
+    string path;
+    vector<GameRecord> queued;
+    bool stopping = false;
+    mutex lock;
+    condition_variable wake;
+    thread writer;
+
+    static void putU32(uint8_t* out, uint32_t value) {
+        for (int i = 0; i < 4; i++) out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+
+    static uint32_t getU32(const uint8_t* in) {
+        return in[0] | (in[1] << 8) | (in[2] << 16) | (static_cast<uint32_t>(in[3]) << 24);
+    }
+
+    // FNV-1a over everything before the checksum field
+    static uint32_t checksum(const uint8_t* record) {
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < RECORD_SIZE - 4; i++) {
+            hash = (hash ^ record[i]) * 16777619u;
+        }
+        return hash;
+    }
+
+    static void encode(const GameRecord& record, uint8_t* out) {
+        memset(out, 0, RECORD_SIZE);
+        putU32(out, MAGIC);
+        out[4] = VERSION;
+        out[5] = record.mode;
+        putU32(out + 8, static_cast<uint32_t>(record.timestamp));
+        putU32(out + 12, static_cast<uint32_t>(record.timestamp >> 32));
+        putU32(out + 16, record.seed);
+        putU32(out + 20, static_cast<uint32_t>(record.score));
+        putU32(out + 24, record.length);
+        putU32(out + 28, record.durationMs);
+        putU32(out + 32, record.ticks);
+        putU32(out + 36, checksum(out));
+    }
+
+    static bool decode(const uint8_t* in, GameRecord& record) {
+        if (getU32(in) != MAGIC || in[4] != VERSION || getU32(in + 36) != checksum(in)) return false;
+        record.mode = in[5];
+        record.timestamp = getU32(in + 8) | (static_cast<uint64_t>(getU32(in + 12)) << 32);
+        record.seed = getU32(in + 16);
+        record.score = static_cast<int32_t>(getU32(in + 20));
+        record.length = getU32(in + 24);
+        record.durationMs = getU32(in + 28);
+        record.ticks = getU32(in + 32);
+        return true;
+    }
+
+    /**
+     * @brief Appends encoded records and syncs them to disk.
+     * @param bytes Whole records
+     */
+    void writeBatch(const vector<uint8_t>& bytes) {
+#ifdef _WIN32
+        int fd = _open(path.c_str(), _O_WRONLY | _O_APPEND | _O_CREAT | _O_BINARY, _S_IREAD | _S_IWRITE);
+        if (fd < 0) return;
+        _write(fd, bytes.data(), static_cast<unsigned int>(bytes.size()));
+        _commit(fd);
+        _close(fd);
+#else
+        int fd = ::open(path.c_str(), O_WRONLY | O_APPEND | O_CREAT, 0644);
+        if (fd < 0) return;
+        size_t written = 0;
+        while (written < bytes.size()) {
+            ssize_t result = write(fd, bytes.data() + written, bytes.size() - written);
+            if (result <= 0) break;
+            written += static_cast<size_t>(result);
+        }
+        fsync(fd);
+        close(fd);
+#endif
+    }
+
+    void run() {
+        vector<GameRecord> batch;
+        vector<uint8_t> bytes;
+        unique_lock<mutex> guard(lock);
+        while (true) {
+            wake.wait(guard, [this] { return stopping || !queued.empty(); });
+            if (queued.empty()) return;
+            batch.swap(queued);
+            guard.unlock();
+
+            bytes.resize(batch.size() * RECORD_SIZE);
+            for (size_t i = 0; i < batch.size(); i++) {
+                encode(batch[i], bytes.data() + i * RECORD_SIZE);
+            }
+            writeBatch(bytes);
+            batch.clear();
+            guard.lock();
+        }
+    }
+
+public:
+    /**
+     * @brief Opens the log for appending (the file is created on the first record).
+     * @param path Log file
+     */
+    explicit ScoreLog(const string& path) : path(path) {
+        writer = thread(&ScoreLog::run, this);
+    }
+
+    ScoreLog(const ScoreLog&) = delete;
+    ScoreLog& operator=(const ScoreLog&) = delete;
+
+    ~ScoreLog() {
+        {
+            lock_guard<mutex> guard(lock);
+            stopping = true;
+        }
+        wake.notify_one();
+        writer.join();
+    }
+
+    /**
+     * @brief Queues a record for the writer thread; never touches the disk.
+     * @param record Finished game
+     */
+    void append(const GameRecord& record) {
+        {
+            lock_guard<mutex> guard(lock);
+            queued.push_back(record);
+        }
+        wake.notify_one();
+    }
+
+    /**
+     * @brief Reads every valid record of the log (written by any instance).
+     * @param visit Called with each record in file order
+     * @return Number of records read (0 if there is no log yet)
+     */
+    template <typename Visit>
+    size_t load(Visit&& visit) const {
+        MappedFile file;
+        if (!file.open(path)) return 0;
+        const uint8_t* data = file.getData();
+        size_t size = file.getSize();
+        size_t count = 0;
+        GameRecord record;
+        for (size_t pos = 0; pos + RECORD_SIZE <= size;) {
+            if (decode(data + pos, record)) {
+                visit(record);
+                count++;
+                pos += RECORD_SIZE;
+            } else {
+                pos++;
+            }
+        }
+        return count;
+    }
+};
+
+/**
+ * @brief Best player games, kept sorted by score (highest first).
+ */
+class Leaderboard {
+private:
+    vector<GameRecord> entries;
+    size_t capacity;
+
+public:
+    explicit Leaderboard(size_t capacity = 10) : capacity(capacity) {}
+
+    /**
+     * @brief Offers a game; demo games and games below the last place are ignored.
+     * @param record Finished game
+     * @return True if it made the board
+     */
+    bool offer(const GameRecord& record) {
+        if (record.mode != 0 || record.score <= 0) return false;
+        if (entries.size() == capacity && record.score <= entries.back().score) return false;
+        auto place = upper_bound(entries.begin(), entries.end(), record,
+                                 [](const GameRecord& a, const GameRecord& b) { return a.score > b.score; });
+        entries.insert(place, record);
+        if (entries.size() > capacity) entries.pop_back();
+        return true;
+    }
+
+    const vector<GameRecord>& getEntries() const { return entries; }
+    int getBestScore() const { return entries.empty() ? 0 : entries.front().score; }
+};
+
+#endif // SCORELOG_H
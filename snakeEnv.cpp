@@ -0,0 +1,45 @@
+// snakeEnv.cpp
+// C entry points of snakeEnv.h over EnvBatch. Build as a shared library:
+//     g++ -std=c++20 -O2 -shared -fPIC -pthread snakeEnv.cpp -o libsnakeenv.so
+#include "envBatch.h"
+
+struct SnakeEnv {
+    EnvBatch batch;
+};
+
+extern "C" {
+
+SnakeEnv* snake_env_create(const SnakeEnvConfig* config) {
+    if (!config) return nullptr;
+    // No C++ exception may cross the C boundary (bad_alloc, thread start failure)
+    try {
+        unique_ptr<SnakeEnv> env = make_unique<SnakeEnv>();
+        if (!env->batch.initialize(*config)) return nullptr;
+        return env.release();
+    } catch (const exception&) {
+        return nullptr;
+    }
+}
+
+void snake_env_destroy(SnakeEnv* env) {
+    delete env;
+}
+
+void snake_env_bind(SnakeEnv* env, const SnakeEnvBuffers* buffers) {
+    SnakeEnvBuffers none = {};
+    env->batch.bind(buffers ? *buffers : none);
+}
+
+void snake_env_reset(SnakeEnv* env, uint32_t seed) {
+    env->batch.reset(seed);
+}
+
+void snake_env_step(SnakeEnv* env, const int32_t* actions) {
+    env->batch.step(actions);
+}
+
+int64_t snake_env_plane_size(const SnakeEnv* env) {
+    return static_cast<int64_t>(env->batch.getPlaneSize());
+}
+
+}
@@ -0,0 +1,127 @@
+/* snakeEnv.h */
+#ifndef SNAKEENV_H
+#define SNAKEENV_H
+
+/*
+ * ============================================================================
+ * TRAINING ENVIRONMENT C API
+ * ============================================================================
+ *
+ * Gym-style batch of Snake environments over SnakeGameLogic, for RL
+ * training loops in any language with a C FFI (ctypes, cffi, Rust, ...).
+ * Build the library with
+ *     g++ -std=c++20 -O2 -shared -fPIC -pthread snakeEnv.cpp -o libsnakeenv.so
+ *
+ * Observations are written straight into caller-owned contiguous arrays
+ * (for example numpy buffers) bound once with snake_env_bind(); reset and
+ * step never allocate and never copy through intermediate objects.
+ *
+ * Plane layout, per environment: SNAKE_ENV_PLANES planes of rows * cols,
+ * row-major, one-hot (1 where the cell holds that thing, 0 elsewhere):
+ *     plane 0  snake head      plane 2  food
+ *     plane 1  snake body      plane 3  wall
+ * so planes[((env * SNAKE_ENV_PLANES + plane) * rows + row) * cols + col].
+ *
+ * Vector-env conventions: an environment that finishes is reset at once,
+ * so after snake_env_step() its observation already shows the next
+ * episode while dones, rewards and scores describe the one that ended.
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SNAKE_ENV_PLANES 4            /**< head, body, food, wall */
+#define SNAKE_ENV_COORDS 4            /**< head row, head col, food row, food col */
+
+#define SNAKE_ENV_RUNNING    0        /**< dones[i]: episode continues */
+#define SNAKE_ENV_TERMINATED 1        /**< dones[i]: the snake died or filled the board */
+#define SNAKE_ENV_TRUNCATED  2        /**< dones[i]: the episode hit maxTicks */
+
+/**
+ * @brief Opaque batch of environments.
+ */
+typedef struct SnakeEnv SnakeEnv;
+
+/**
+ * @brief Batch parameters (zero fields take the defaults shown).
+ */
+typedef struct SnakeEnvConfig {
+    int32_t envCount;                 /**< Number of environments (required, > 0) */
+    int32_t rows;                     /**< Board rows (default 20) */
+    int32_t cols;                     /**< Board columns (default 40) */
+    int32_t startingLength;           /**< Initial snake length (default 3) */
+    int32_t pointsPerFood;            /**< Score per food (default 10) */
+    uint32_t maxTicks;                /**< Episode tick limit (default 100 * rows * cols) */
+    int32_t threads;                  /**< Worker threads stepping the batch; 0 or 1 steps on the caller */
+    const uint8_t* walls;             /**< Optional rows * cols map, nonzero = wall; copied at creation */
+} SnakeEnvConfig;
+
+/**
+ * @brief Caller-owned output arrays; any pointer may be NULL to skip that output.
+ *
+ * Planes are updated incrementally (only the cells that changed are
+ * rewritten), so the arrays must not be modified between calls; bind
+ * again to draw into a different array.
+ */
+typedef struct SnakeEnvBuffers {
+    float* planes;                    /**< envCount * SNAKE_ENV_PLANES * rows * cols */
+    uint8_t* planesU8;                /**< Same layout as planes, as 0 / 1 bytes */
+    float* coords;                    /**< envCount * SNAKE_ENV_COORDS; food is -1, -1 when absent */
+    float* rewards;                   /**< envCount: +1 per food, -1 on death */
+    uint8_t* dones;                   /**< envCount: SNAKE_ENV_RUNNING / TERMINATED / TRUNCATED */
+    int32_t* scores;                  /**< envCount: episode score (the finished one when done) */
+} SnakeEnvBuffers;
+
+/**
+ * @brief Creates a batch; every environment starts as if reset with seed 0.
+ * @param config Batch parameters
+ * @return New batch, or NULL if the parameters are invalid
+ */
+SnakeEnv* snake_env_create(const SnakeEnvConfig* config);
+
+/**
+ * @brief Stops the workers and frees the batch.
+ * @param env Batch from snake_env_create (NULL is ignored)
+ */
+void snake_env_destroy(SnakeEnv* env);
+
+/**
+ * @brief Binds the output arrays and writes the current observations into them.
+ * @param env Batch
+ * @param buffers Arrays to write on every reset and step
+ */
+void snake_env_bind(SnakeEnv* env, const SnakeEnvBuffers* buffers);
+
+/**
+ * @brief Starts a new episode in every environment.
+ *
+ * Environment i is seeded with seed + i; its later automatic resets use
+ * seed + i + k * envCount, so a run is reproducible for any thread count.
+ * @param env Batch
+ * @param seed Seed of environment 0
+ */
+void snake_env_reset(SnakeEnv* env, uint32_t seed);
+
+/**
+ * @brief Advances every environment by one tick.
+ * @param env Batch
+ * @param actions envCount directions (0 up, 1 down, 2 left, 3 right);
+ *        reversals and other values keep the current direction
+ */
+void snake_env_step(SnakeEnv* env, const int32_t* actions);
+
+/**
+ * @brief Gets the number of floats (or bytes) of one environment's planes.
+ * @param env Batch
+ * @return SNAKE_ENV_PLANES * rows * cols
+ */
+int64_t snake_env_plane_size(const SnakeEnv* env);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SNAKEENV_H */
@@ -0,0 +1,424 @@
+// spectatorServer.h
+#ifndef SPECTATORSERVER_H
+#define SPECTATORSERVER_H
+
+#include "gameLogic.h"
+#include <functional>
+#include <string>
+
+#ifndef _WIN32
+    #include <arpa/inet.h>
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <netinet/in.h>
+    #include <netinet/tcp.h>
+    #include <sys/socket.h>
+    #include <sys/uio.h>
+    #include <unistd.h>
+    #ifdef __linux__
+        #include <sys/epoll.h>
+    #else
+        #include <poll.h>
+    #endif
+#endif
+
+// ============================================================================
+// SPECTATOR SERVER
+// ============================================================================
+
+/**
+ * @brief Streams published game states to TCP clients.
+ *
+ * Wire format: a sequence of messages, each a u32 length (of the rest of
+ * the message), a u8 type and the payload, all little-endian.
+ *   KEYFRAME (1): u64 generation, u32 rows, u32 cols, i32 score,
+ *                 u8 gameOver, u32 head, u32 length, rows * cols CellType bytes
+ *   DELTA    (2): u64 generation, i32 score, u8 gameOver, u32 head,
+ *                 u32 length, u16 count, count * (u32 cell, u8 CellType)
+ * head is the flat index of the snake's head and length the snake length;
+ * a DELTA holds the cells that changed (new head, freed tail, eaten and
+ * placed food) since the previous message.
+ *
+ * A joining client gets a keyframe of the current state, then every
+ * broadcast. Each broadcast is encoded once, straight into a slot of a
+ * shared history ring, and all clients are sent from those same bytes: one
+ * sendmsg() per client per broadcast gathers whatever that client has not
+ * received yet, so there is no per-client copy or formatting. A broadcast
+ * that does not directly follow the previous generation (or whose deltas
+ * overflowed) is sent as a keyframe instead.
+ *
+ * A client that falls a whole ring behind is resynchronised with a fresh
+ * keyframe, and dropped if it falls behind again before that was sent.
+ * Bytes from clients are read as directions (0 UP, 1 DOWN, 2 LEFT, 3 RIGHT)
+ * and passed to the input handler, if one is set; others are ignored.
+ *
+ * Single-threaded: start() and broadcast() must be called from one thread,
+ * usually the logic thread right after update(). Accepting clients and
+ * reading input also happen inside broadcast() (epoll on Linux, poll
+ * elsewhere), so the server needs no thread of its own. POSIX only; on
+ * Windows start() fails.
+ */
+class SpectatorServer {
+public:
+    enum MessageType : uint8_t {
+        KEYFRAME = 1,
+        DELTA = 2
+    };
+
+    using InputHandler = function<void(uint32_t client, Direction dir)>;
+
+private:
+    static constexpr uint64_t HISTORY = 256;        ///< Broadcasts kept for slow clients
+    static constexpr size_t MAX_IOV = 64;
+    static constexpr size_t KEYFRAME_HEADER = 4 + 1 + 8 + 4 + 4 + 4 + 1 + 4 + 4;
+    static constexpr size_t DELTA_HEADER = 4 + 1 + 8 + 4 + 1 + 4 + 4 + 2;
+    static constexpr size_t DELTA_SIZE = 5;
+
+    /**
+     * @brief One connected client and how far it has been sent.
+     */
+    struct Client {
+        int fd;
+        uint32_t id;
+        vector<uint8_t> own;         ///< Private bytes (keyframe) sent before the history
+        size_t ownSent;
+        uint64_t nextTick;           ///< First broadcast not yet fully sent
+        size_t offset;               ///< Bytes of that broadcast already sent
+        bool joining;                ///< Still needs its first keyframe
+    };
+
+    vector<vector<uint8_t>> history; ///< Encoded broadcasts, slot tick % HISTORY
+    uint64_t tick = 0;               ///< Number of the last encoded broadcast
+    uint64_t lastGeneration = 0;
+    vector<Client> clients;
+    vector<int32_t> clientOfFd;      ///< Index into clients, or -1
+    uint32_t nextClientId = 0;
+    InputHandler inputHandler;
+    int listenFd = -1;
+#ifdef __linux__
+    int epollFd = -1;
+#endif
+
+    static void putU16(uint8_t* out, uint16_t value) {
+        out[0] = static_cast<uint8_t>(value);
+        out[1] = static_cast<uint8_t>(value >> 8);
+    }
+
+    static void putU32(uint8_t* out, uint32_t value) {
+        for (int i = 0; i < 4; i++) out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+
+    static void putU64(uint8_t* out, uint64_t value) {
+        for (int i = 0; i < 8; i++) out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+
+    static uint32_t headIndex(const GameState& state) {
+        return static_cast<uint32_t>(state.snakeHead.first * state.cols + state.snakeHead.second);
+    }
+
+    /**
+     * @brief Appends a keyframe of a state to a buffer.
+     * @param out Buffer to append to (grown, the cells copied in with one memcpy)
+     * @param state State to encode
+     */
+    static void appendKeyframe(vector<uint8_t>& out, const GameState& state) {
+        size_t cells = state.board.size();
+        size_t start = out.size();
+        out.resize(start + KEYFRAME_HEADER + cells);
+        uint8_t* p = out.data() + start;
+        putU32(p, static_cast<uint32_t>(KEYFRAME_HEADER - 4 + cells));
+        p[4] = KEYFRAME;
+        putU64(p + 5, state.generation);
+        putU32(p + 13, static_cast<uint32_t>(state.rows));
+        putU32(p + 17, static_cast<uint32_t>(state.cols));
+        putU32(p + 21, static_cast<uint32_t>(state.score));
+        p[25] = state.gameOver;
+        putU32(p + 26, headIndex(state));
+        putU32(p + 30, static_cast<uint32_t>(state.snakeLength));
+        memcpy(p + KEYFRAME_HEADER, state.board.data(), cells);
+    }
+
+    /**
+     * @brief Encodes a state's deltas into a buffer.
+     * @param out Buffer to overwrite (reused, so steady state does not allocate)
+     * @param state State to encode
+     */
+    static void writeDelta(vector<uint8_t>& out, const GameState& state) {
+        size_t count = state.deltaCount;
+        out.resize(DELTA_HEADER + count * DELTA_SIZE);
+        uint8_t* p = out.data();
+        putU32(p, static_cast<uint32_t>(out.size() - 4));
+        p[4] = DELTA;
+        putU64(p + 5, state.generation);
+        putU32(p + 13, static_cast<uint32_t>(state.score));
+        p[17] = state.gameOver;
+        putU32(p + 18, headIndex(state));
+        putU32(p + 22, static_cast<uint32_t>(state.snakeLength));
+        putU16(p + 26, static_cast<uint16_t>(count));
+        p += DELTA_HEADER;
+        for (size_t i = 0; i < count; i++, p += DELTA_SIZE) {
+            putU32(p, state.deltas[i].index);
+            p[4] = state.deltas[i].type;
+        }
+    }
+
+#ifndef _WIN32
+    void addClient(int fd) {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+        int on = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+#ifdef __linux__
+        epoll_event event = {};
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.fd = fd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+#endif
+        if (static_cast<size_t>(fd) >= clientOfFd.size()) clientOfFd.resize(fd + 1, -1);
+        clientOfFd[fd] = static_cast<int32_t>(clients.size());
+        clients.push_back({fd, nextClientId++, {}, 0, 0, 0, true});
+    }
+
+    void removeClient(size_t index) {
+        int fd = clients[index].fd;
+#ifdef __linux__
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+#endif
+        close(fd);
+        clientOfFd[fd] = -1;
+        if (index + 1 != clients.size()) {
+            clients[index] = move(clients.back());
+            clientOfFd[clients[index].fd] = static_cast<int32_t>(index);
+        }
+        clients.pop_back();
+    }
+
+    void acceptClients() {
+        while (true) {
+            int fd = accept(listenFd, nullptr, nullptr);
+            if (fd < 0) return;
+            addClient(fd);
+        }
+    }
+
+    /**
+     * @brief Reads what a client sent; directions go to the input handler.
+     * @param fd Client socket
+     * @return False if the client disconnected
+     */
+    bool readClient(int fd) {
+        uint8_t buffer[256];
+        while (true) {
+            ssize_t got = recv(fd, buffer, sizeof(buffer), 0);
+            if (got == 0) return false;
+            if (got < 0) return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+            if (!inputHandler) continue;
+            uint32_t id = clients[clientOfFd[fd]].id;
+            for (ssize_t i = 0; i < got; i++) {
+                if (buffer[i] < NONE) inputHandler(id, static_cast<Direction>(buffer[i]));
+            }
+        }
+    }
+
+    // Handles new connections, input and hang-ups without blocking
+    void pollEvents() {
+#ifdef __linux__
+        epoll_event events[64];
+        int count;
+        do {
+            count = epoll_wait(epollFd, events, 64, 0);
+            for (int i = 0; i < count; i++) {
+                int fd = events[i].data.fd;
+                if (fd == listenFd) {
+                    acceptClients();
+                } else if (clientOfFd[fd] >= 0 &&
+                           ((events[i].events & (EPOLLHUP | EPOLLERR)) || !readClient(fd))) {
+                    removeClient(clientOfFd[fd]);
+                }
+            }
+        } while (count == 64);
+#else
+        vector<pollfd> fds(clients.size() + 1);
+        fds[0] = {listenFd, POLLIN, 0};
+        for (size_t i = 0; i < clients.size(); i++) fds[i + 1] = {clients[i].fd, POLLIN, 0};
+        if (::poll(fds.data(), fds.size(), 0) <= 0) return;
+        for (size_t i = fds.size() - 1; i > 0; i--) {
+            if (fds[i].revents && ((fds[i].revents & (POLLHUP | POLLERR)) || !readClient(fds[i].fd))) {
+                removeClient(clientOfFd[fds[i].fd]);
+            }
+        }
+        if (fds[0].revents & POLLIN) acceptClients();
+#endif
+    }
+
+    /**
+     * @brief Sends a client everything it is missing with one gathered send.
+     * @param client Client to flush
+     * @return False if the connection failed
+     */
+    bool flush(Client& client) {
+        iovec iov[MAX_IOV];
+        size_t count = 0;
+        if (client.ownSent < client.own.size()) {
+            iov[count++] = {client.own.data() + client.ownSent, client.own.size() - client.ownSent};
+        }
+        for (uint64_t t = client.nextTick; t <= tick && count < MAX_IOV; t++) {
+            vector<uint8_t>& message = history[t % HISTORY];
+            size_t skip = t == client.nextTick ? client.offset : 0;
+            iov[count++] = {message.data() + skip, message.size() - skip};
+        }
+        if (count == 0) return true;
+
+        msghdr header = {};
+        header.msg_iov = iov;
+        header.msg_iovlen = count;
+        ssize_t sent = sendmsg(client.fd, &header, MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (sent < 0) return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+
+        size_t remaining = static_cast<size_t>(sent);
+        if (client.ownSent < client.own.size()) {
+            size_t take = min(remaining, client.own.size() - client.ownSent);
+            client.ownSent += take;
+            remaining -= take;
+            if (client.ownSent == client.own.size()) {
+                client.own.clear();
+                client.ownSent = 0;
+            } else {
+                return true;
+            }
+        }
+        while (remaining > 0) {
+            size_t rest = history[client.nextTick % HISTORY].size() - client.offset;
+            if (remaining < rest) {
+                client.offset += remaining;
+                break;
+            }
+            remaining -= rest;
+            client.nextTick++;
+            client.offset = 0;
+        }
+        return true;
+    }
+#endif
+
+public:
+    SpectatorServer() : history(HISTORY) {}
+    SpectatorServer(const SpectatorServer&) = delete;
+    SpectatorServer& operator=(const SpectatorServer&) = delete;
+
+    ~SpectatorServer() {
+#ifndef _WIN32
+        while (!clients.empty()) removeClient(clients.size() - 1);
+        if (listenFd >= 0) close(listenFd);
+#ifdef __linux__
+        if (epollFd >= 0) close(epollFd);
+#endif
+#endif
+    }
+
+    /**
+     * @brief Listens for clients on a TCP port (all interfaces).
+     * @param port Port to listen on
+     * @param error Receives the reason on failure
+     * @return True if the server is listening
+     */
+    bool start(uint16_t port, string& error) {
+#ifdef _WIN32
+        (void)port;
+        error = "spectator server is not supported on Windows";
+        return false;
+#else
+        listenFd = socket(AF_INET, SOCK_STREAM, 0);
+        if (listenFd < 0) {
+            error = string("socket: ") + strerror(errno);
+            return false;
+        }
+        int on = 1;
+        setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_ANY);
+        address.sin_port = htons(port);
+        if (bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+            listen(listenFd, SOMAXCONN) != 0) {
+            error = "port " + to_string(port) + ": " + strerror(errno);
+            close(listenFd);
+            listenFd = -1;
+            return false;
+        }
+        fcntl(listenFd, F_SETFL, fcntl(listenFd, F_GETFL, 0) | O_NONBLOCK);
+#ifdef __linux__
+        epollFd = epoll_create1(0);
+        epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.fd = listenFd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event);
+#endif
+        return true;
+#endif
+    }
+
+    /**
+     * @brief Sets the callback receiving directions sent by clients.
+     * @param handler Called from broadcast() with the client id and direction
+     */
+    void setInputHandler(InputHandler handler) {
+        inputHandler = move(handler);
+    }
+
+    /**
+     * @brief Sends a state to every client (call once per published generation).
+     * @param state Latest published state
+     */
+    void broadcast(const GameState& state) {
+#ifndef _WIN32
+        if (listenFd < 0) return;
+        pollEvents();
+
+        tick++;
+        vector<uint8_t>& message = history[tick % HISTORY];
+        if (state.deltasComplete && state.generation == lastGeneration + 1) {
+            writeDelta(message, state);
+        } else {
+            message.clear();
+            appendKeyframe(message, state);
+        }
+        lastGeneration = state.generation;
+
+        for (size_t i = clients.size(); i-- > 0;) {
+            Client& client = clients[i];
+            if (client.joining) {
+                appendKeyframe(client.own, state);
+                client.nextTick = tick + 1;
+                client.joining = false;
+            }
+            if (!flush(client)) {
+                removeClient(i);
+                continue;
+            }
+
+            // The next broadcast reuses the slot this client still needs:
+            // keep the rest of its partial message, then resync
+            if (client.nextTick + HISTORY <= tick + 1) {
+                if (!client.own.empty()) {
+                    removeClient(i);
+                    continue;
+                }
+                if (client.offset > 0) {
+                    const vector<uint8_t>& partial = history[client.nextTick % HISTORY];
+                    client.own.assign(partial.begin() + client.offset, partial.end());
+                }
+                appendKeyframe(client.own, state);
+                client.nextTick = tick + 1;
+                client.offset = 0;
+            }
+        }
+#else
+        (void)state;
+#endif
+    }
+
+    size_t getClientCount() const { return clients.size(); }
+    bool isRunning() const { return listenFd >= 0; }
+};
+
+#endif // SPECTATORSERVER_H